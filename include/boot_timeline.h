@@ -0,0 +1,32 @@
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <Arduino.h>
+
+// Records how long each boot stage took, from power-on to fully ready
+
+#define BOOT_TIMELINE_MAX_STAGES 16
+
+struct BootStage {
+    const char *name;
+    uint32_t end_ms;       // millis() when the stage finished
+    uint32_t duration_ms;  // Time since the previous stage finished
+};
+
+// Record the end of a stage (name must be a string literal)
+void markBootStage(const char *name);
+
+// First frame is on the panel (records a "first_frame" stage)
+void markBootFirstFrame();
+
+// All deferred stages have run (records a "ready" stage)
+void markBootComplete();
+
+uint8_t getBootStageCount();
+const BootStage& getBootStage(uint8_t index);
+
+// 0 until the event happened
+uint32_t getBootFirstFrameMs();
+uint32_t getBootReadyMs();
+
+#endif // BOOT_TIMELINE_H
@@ -13,6 +13,13 @@ enum IdleTimeout {
     IDLE_60_SEC = 60
 };
 
+// When the display may sleep (backlight off, no rendering, panel scanout stopped)
+enum SleepMode {
+    SLEEP_NEVER = 0,
+    SLEEP_NIGHT = 1,   // Only during night hours
+    SLEEP_ALWAYS = 2
+};
+
 struct BrightnessConfig {
     // Day/Night brightness settings (0-100)
     uint8_t dayBrightness = 100;
@@ -27,6 +34,11 @@ struct BrightnessConfig {
     bool nightIdleDimmingEnabled = false;
     IdleTimeout idleTimeout = IDLE_NEVER;
     uint8_t idleBrightness = 80;  // Percentage to dim to when idle
+
+    // Display sleep (a brightness of 0% always sleeps)
+    SleepMode sleepMode = SLEEP_NEVER;
+    uint16_t sleepTimeout = 300;  // Seconds without touch before sleeping
+    bool wakeOnOffGrid = true;    // Wake when the site goes off-grid
 };
 
 class BrightnessConfigManager {
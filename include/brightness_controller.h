@@ -3,7 +3,7 @@
 
 #include <Arduino.h>
 #include "brightness_config.h"
-#include "time_config.h"
+#include "wall_clock.h"
 
 // Backlight pin for ESP32-S3-4848S040
 #define BACKLIGHT_PIN 38
@@ -23,20 +23,40 @@ public:
     // Brightness control
     void setBrightness(uint8_t brightness);  // Set brightness 0-100%
     uint8_t getCurrentBrightness();
+    bool isDimmed();  // Idle dimmed or below day brightness (night)
     
     // Idle detection
-    void onTouchDetected();  // Call when touch is detected
+    bool onTouchDetected();  // Call when touch is detected; true if the touch hit a sleeping display
+
+    // Display sleep: the callback suspends rendering and the panel (asleep)
+    // or restores them and draws the first frame (awake) before the backlight returns
+    void setSleepCallback(void (*callback)(bool asleep));
+    bool isAsleep();
+    void requestWake();   // Safe from any task; handled in update()
+    void requestSleep();
+
+    // Wall-clock hour subscription (-1 while time is unknown)
+    void onHourChanged(int hour);
     
 private:
     uint8_t currentBrightness;
     uint8_t targetBrightness;  // For scheduled brightness
     unsigned long lastTouchTime;
     bool isDimmedByIdle;
+    int currentHour;  // Cached from the wall clock, -1 until time is set
+    bool asleep;
+    bool sleepForced;  // Asleep by requestSleep(), not by schedule or idle
+    volatile bool wakeRequested;
+    volatile bool sleepRequested;
+    void (*sleepCallback)(bool asleep);
     
     // Internal helpers
     void applyBrightness(uint8_t brightness);
     uint8_t getScheduledBrightness();  // Get brightness based on time of day
     bool shouldDimForIdle();
+    bool shouldSleep();
+    void enterSleep();
+    void exitSleep();
     bool isDayTime();  // Check if current time is in day mode
 };
 
@@ -5,6 +5,7 @@
 
 // Config screen management
 void createConfigScreen();
+void destroyConfigScreen();
 void showConfigScreen();
 void hideConfigScreen();
 bool isConfigScreenVisible();
@@ -0,0 +1,19 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <lvgl.h>
+
+// Pre-expand the dashboard value glyphs of the space_bold fonts to A8 bitmaps
+void initGlyphCache();
+
+// Create a single-line label that blits cached glyphs instead of decoding the font.
+// Uses the object's text color/opa/align styles like a regular lv_label (font is fixed).
+lv_obj_t* createGlyphLabel(lv_obj_t *parent, const lv_font_t *font);
+
+// Set label text, optionally followed by a second span drawn in the accent color
+void setGlyphLabelText(lv_obj_t *label, const char *text, const char *accent = nullptr);
+
+// Set the color used for the accent span (e.g. gray units)
+void setGlyphLabelAccentColor(lv_obj_t *label, lv_color_t color);
+
+#endif // GLYPH_CACHE_H
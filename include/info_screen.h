@@ -5,6 +5,7 @@
 
 // Info screen management
 void createInfoScreen();
+void destroyInfoScreen();
 void showInfoScreen();
 void hideInfoScreen();
 bool isInfoScreenVisible();
@@ -0,0 +1,45 @@
+#ifndef LAZY_SCREENS_H
+#define LAZY_SCREENS_H
+
+#include <Arduino.h>
+
+// Secondary screens are created on first show and may be destroyed
+// again after staying off-screen for their idle timeout.
+
+enum LazyScreenId : uint8_t {
+    LAZY_SCREEN_INFO = 0,
+    LAZY_SCREEN_CONFIG,
+    LAZY_SCREEN_MQTT_CONFIG,
+    LAZY_SCREEN_WIFI_ERROR,
+    LAZY_SCREEN_COUNT
+};
+
+// Idle timeout value that keeps a screen resident once created
+#define LAZY_SCREEN_KEEP 0
+
+typedef void (*LazyScreenCreateFn)();
+typedef void (*LazyScreenDestroyFn)();
+typedef bool (*LazyScreenVisibleFn)();
+
+struct LazyScreenStats {
+    const char *name;
+    bool resident;
+    uint16_t create_count;
+    uint32_t last_create_us;   // Time spent in the create function
+    int32_t last_mem_bytes;    // LVGL heap taken by the last creation
+};
+
+// Register a screen's lifecycle callbacks (does not create it)
+void registerLazyScreen(LazyScreenId id, const char *name,
+                        LazyScreenCreateFn create, LazyScreenDestroyFn destroy,
+                        LazyScreenVisibleFn is_visible, unsigned long idle_timeout_ms);
+
+// Create the screen if it isn't resident. Returns true if it exists afterwards.
+bool ensureLazyScreen(LazyScreenId id);
+
+// Destroy screens that have been off-screen past their timeout (call from loop)
+void updateLazyScreens();
+
+const LazyScreenStats& getLazyScreenStats(LazyScreenId id);
+
+#endif // LAZY_SCREENS_H
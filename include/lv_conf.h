@@ -9,8 +9,12 @@
 #define LV_COLOR_16_SWAP 0
 
 /* Memory settings */
-#define LV_MEM_CUSTOM 0
-#define LV_MEM_SIZE (128U * 1024U)
+/* LVGL heap lives in PSRAM with a small internal pool for small objects (see lvgl_heap.h) */
+#define LV_MEM_CUSTOM 1
+#define LV_MEM_CUSTOM_INCLUDE "lvgl_heap.h"
+#define LV_MEM_CUSTOM_ALLOC lvgl_heap_alloc
+#define LV_MEM_CUSTOM_FREE lvgl_heap_free
+#define LV_MEM_CUSTOM_REALLOC lvgl_heap_realloc
 
 /* Display settings */
 #define LV_HOR_RES_MAX 480
@@ -60,7 +64,7 @@
 #define LV_USE_SWITCH 1
 #define LV_USE_TEXTAREA 1
 #define LV_USE_TABLE 1
-#define LV_USE_SPINNER 1
+#define LV_USE_SPINNER 0
 
 /* Others */
 #define LV_USE_ANIMATION 1
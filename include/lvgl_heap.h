@@ -0,0 +1,49 @@
+#ifndef LVGL_HEAP_H
+#define LVGL_HEAP_H
+
+// LVGL custom allocator (LV_MEM_CUSTOM). Included from LVGL's C sources, so
+// this header must stay plain C.
+//
+// Two pools:
+//  - a large PSRAM pool for the bulk of LVGL objects, styles and buffers
+//  - a small internal SRAM pool for hot small allocations (<= LVGL_HEAP_FAST_MAX)
+// If both pools are exhausted, allocations fall back to the system PSRAM heap
+// and are counted as overflows.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LVGL_HEAP_PSRAM_SIZE (512U * 1024U)
+#define LVGL_HEAP_FAST_SIZE  (16U * 1024U)
+#define LVGL_HEAP_FAST_MAX   64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t total_bytes;         // Both pools
+    uint32_t used_bytes;
+    uint32_t free_bytes;
+    uint32_t largest_free_block;  // In the PSRAM pool
+    uint32_t min_free_bytes;      // Low-water mark of the PSRAM pool
+    uint8_t frag_pct;             // 100 - largest_free * 100 / free (PSRAM pool)
+    uint32_t fast_used_bytes;
+    uint32_t fast_free_bytes;
+    uint32_t alloc_count;
+    uint32_t fast_alloc_count;
+    uint32_t overflow_count;      // Served by the system heap
+    uint32_t failure_count;       // Returned NULL
+} lvgl_heap_stats_t;
+
+void *lvgl_heap_alloc(size_t size);
+void lvgl_heap_free(void *ptr);
+void *lvgl_heap_realloc(void *ptr, size_t new_size);
+
+void lvgl_heap_get_stats(lvgl_heap_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LVGL_HEAP_H
@@ -2,6 +2,8 @@
 #define MAIN_SCREEN_H
 
 #include <lvgl.h>
+#include "metrics_store.h"
+#include "power_flow.h"
 
 // Main screen management
 void createMainDashboard();
@@ -22,9 +24,19 @@ void updateEVConnected(bool connected);
 void updateEVSOC(float percent);
 void setEVEnabled(bool enabled);
 
-// Animation updates (called from main loop)
+// Extra flow nodes (generator, battery or EV roles) shown as badges in free
+// icon slots; index follows the order given here
+void configureExtraNodes(const PowerNodeRole *roles, uint8_t count);
+void updateExtraNodeValue(uint8_t index, float watts);
+
+// Show values from the last session (dimmed, no RX pulse) until fresh data arrives
+void applyRestoredMetrics(const StoredMetrics &metrics);
+
+// Animation updates (called from main loop). Both pause while the dashboard
+// is covered and slow down while the backlight is dimmed.
 void updateDataRxPulse();
 void updatePowerFlowAnimation();
+void setDashboardDimmed(bool dimmed);
 
 // Timing variable for data RX indicator
 extern unsigned long last_data_ms;
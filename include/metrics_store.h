@@ -0,0 +1,50 @@
+#ifndef METRICS_STORE_H
+#define METRICS_STORE_H
+
+#include <Arduino.h>
+
+// Last received dashboard values, kept in RTC memory (survives soft resets)
+// and coalesced to NVS (survives power loss) so the dashboard can show them
+// immediately after a reboot.
+
+// First NVS write after boot, then at most one write per interval
+#define METRICS_NVS_FIRST_DELAY_MS 30000
+#define METRICS_NVS_INTERVAL_MS    600000  // 10 minutes
+
+enum MetricId : uint8_t {
+    METRIC_SOLAR = 0,
+    METRIC_GRID,
+    METRIC_HOME,
+    METRIC_BATTERY,
+    METRIC_SOC,
+    METRIC_OFFGRID,
+    METRIC_TIME_REMAINING,
+    METRIC_EV,
+    METRIC_EV_CONNECTED,
+    METRIC_EV_SOC,
+    METRIC_COUNT
+};
+
+struct StoredMetrics {
+    float values[METRIC_COUNT];
+    uint16_t valid_mask;   // Bit per MetricId that has a value
+    uint32_t saved_epoch;  // Wall-clock time of the last update, 0 if the clock was unsynced
+};
+
+// Record a freshly received value (cheap, call from the data callbacks)
+void recordMetric(MetricId id, float value);
+
+// Load the last snapshot (RTC first, then NVS). Returns false if there is none.
+bool loadStoredMetrics(StoredMetrics &out);
+
+// Write the snapshot to NVS when it is due (call from loop)
+void loopMetricsStore();
+
+// Where the boot snapshot came from: "rtc", "nvs" or "none"
+const char* getMetricsRestoreSource();
+
+inline bool hasMetric(const StoredMetrics &metrics, MetricId id) {
+    return metrics.valid_mask & (1U << id);
+}
+
+#endif // METRICS_STORE_H
@@ -4,12 +4,47 @@
 #include <Arduino.h>
 #include <AsyncMqttClient.h>
 #include <Preferences.h>
+#include "mqtt_topics.h"
+#include "power_flow.h"
 
 // Constants
 #define MAX_MQTT_MESSAGE_SIZE 64
 #define MQTT_RECONNECT_MIN_DELAY 1000    // Start with 1 second
 #define MQTT_RECONNECT_MAX_DELAY 60000   // Max 60 seconds
 
+// Broker failover
+#define MQTT_MAX_ENDPOINTS 4              // Primary + up to 3 fallbacks
+#define MQTT_CONNECT_TIMEOUT 5000         // Give up on an attempt (and fail over) after this
+#define MQTT_FAILOVER_DELAY 250           // Delay before trying the next endpoint
+#define MQTT_ENDPOINT_COOLDOWN 30000      // A failed endpoint is skipped for this long
+#define MQTT_DNS_CACHE_TTL 3600000        // Re-resolve hostnames hourly (or after a failure)
+#define MQTT_LATENCY_UNKNOWN 5000.0f      // Score of an endpoint that never connected
+#define MQTT_LATENCY_EWMA_ALPHA 0.3f
+
+// Extra flow nodes (generator, more batteries or EV chargers), one power topic each
+#define MQTT_MAX_EXTRA_NODES 3
+
+// Ingestion: one latest-value slot per pypowerwall topic plus the EV topics
+#define MQTT_INGEST_EV_POWER     TOPIC_COUNT
+#define MQTT_INGEST_EV_CONNECTED (TOPIC_COUNT + 1)
+#define MQTT_INGEST_EV_SOC       (TOPIC_COUNT + 2)
+#define MQTT_INGEST_EXTRA        (TOPIC_COUNT + 3)  // One channel per extra flow node
+#define MQTT_INGEST_CHANNELS     (MQTT_INGEST_EXTRA + MQTT_MAX_EXTRA_NODES)
+#define MQTT_INGEST_DEFAULT_RATE 50  // Messages applied per second, 0 = unlimited
+
+// Retained bootstrap
+#define MQTT_BOOTSTRAP_PUBLISH_INTERVAL 60000  // Companion last-value republish, per topic
+// Topics that make a complete dashboard (offgrid and time remaining are optional)
+#define MQTT_BOOTSTRAP_MASK ((1U << TOPIC_SOLAR) | (1U << TOPIC_GRID) | (1U << TOPIC_HOME) | \
+                             (1U << TOPIC_BATTERY) | (1U << TOPIC_SOC))
+
+// One extra flow node parsed from MQTTConfig::extra_nodes
+struct MQTTExtraNode {
+    PowerNodeRole role;  // NODE_GENERATOR, NODE_BATTERY or NODE_EV
+    String topic;        // Full topic path, watts (battery > 0 discharges)
+    float last_w;
+};
+
 // MQTT Configuration structure
 struct MQTTConfig {
     String host;
@@ -17,12 +52,60 @@ struct MQTTConfig {
     String user;
     String password;
     String topic_prefix;
+    String fallback_brokers;    // Comma-separated "host[:port]" list, tried when the primary fails
+    bool wildcard_subscribe;    // One subscription instead of one per topic
+    String subscribe_filter;    // Wildcard filter, empty = "{topic_prefix}#"
+
+    // Session and delivery
+    bool clean_session;              // false = persistent session, broker keeps subscriptions/queued QoS 1
+    uint8_t topic_qos[TOPIC_COUNT];  // Subscription QoS per pypowerwall topic (0 or 1)
+    uint8_t ev_qos;
+    String bootstrap_prefix;         // Companion topic for retained last values, empty = off
+    uint16_t max_rate;               // Ingest processing limit (messages/s), 0 = unlimited
 
     // EV Charger configuration (optional)
     bool ev_enabled;
     String ev_power_topic;      // Required if enabled - full MQTT topic path
     String ev_connected_topic;  // Optional - vehicle connected status
     String ev_soc_topic;        // Optional - vehicle charge level %
+
+    // Extra flow nodes: "role:topic,..." with role generator, battery or ev
+    String extra_nodes;
+};
+
+// How fast the dashboard filled in after the last connect
+struct MQTTBootstrapStats {
+    bool session_present;        // Broker resumed a persistent session
+    bool resubscribed;           // Subscriptions were (re)sent on the last connect
+    uint32_t retained_received;  // Messages delivered with the retain flag
+    uint32_t companion_applied;  // Values taken from the companion topic
+    uint32_t last_bootstrap_ms;  // Connect -> all MQTT_BOOTSTRAP_MASK topics, 0 = not yet
+};
+
+// Counters for messages arriving from the broker
+struct MQTTIngestStats {
+    uint32_t received;
+    uint32_t ignored;       // Not a topic we use (or a stale companion value)
+    uint32_t oversized;     // Larger than MAX_MQTT_MESSAGE_SIZE or fragmented
+    uint32_t coalesced;     // Replaced by a newer value before it was processed
+    uint32_t processed;
+    uint32_t parse_errors;
+    uint32_t rate_limited;  // loop() passes that left work pending for the rate limit
+    uint32_t process_us_total;  // Parse + dispatch + UI callbacks
+    uint32_t process_us_max;
+};
+
+// One broker address with its cached DNS result and connect history
+struct MQTTEndpoint {
+    String host;
+    uint16_t port = 0;
+    IPAddress addr;                  // Cached resolved address
+    unsigned long resolved_at = 0;   // 0 = not resolved
+    bool literal = false;            // Host is already an IP address
+    float latency_ms = 0;            // EWMA of connect latency, 0 = never connected
+    uint32_t connects = 0;
+    uint32_t failures = 0;
+    unsigned long failed_at = 0;     // 0 = no recent failure
 };
 
 // MQTT Client class
@@ -37,8 +120,19 @@ public:
 
     bool isConnected();
     MQTTConfig& getConfig();
+    String getSubscribeFilter();  // Filter used in wildcard mode
     void disconnect();
     void connect();
+    void reinit();  // Drop and rebuild the session (network recovery)
+
+    // Broker endpoints (primary first), -1 if none is active
+    uint8_t getEndpointCount();
+    const MQTTEndpoint& getEndpoint(uint8_t index);
+    int getActiveEndpoint();
+    const MQTTBootstrapStats& getBootstrapStats();
+    const MQTTIngestStats& getIngestStats();
+    void resetIngestStats();  // Benchmark runs (tools/mqtt_trace.py)
+    const char* getClientId();
     
     // Callback setters for MQTT data updates
     void setSolarCallback(void (*callback)(float));
@@ -54,6 +148,11 @@ public:
     void setEVConnectedCallback(void (*callback)(bool));
     void setEVSOCCallback(void (*callback)(float));
 
+    // Extra flow nodes (index into getExtraNode)
+    uint8_t getExtraNodeCount();
+    const MQTTExtraNode& getExtraNode(uint8_t index);
+    void setExtraNodeCallback(void (*callback)(uint8_t, float));
+
 private:
     AsyncMqttClient mqtt_client;
     MQTTConfig config;
@@ -61,8 +160,43 @@ private:
 
     // Auto-reconnect state
     bool reconnect_enabled;
-    unsigned long last_reconnect_attempt;
+    unsigned long next_attempt_at;
     unsigned long reconnect_delay;
+
+    // Endpoints and the attempt in progress
+    MQTTEndpoint endpoints[MQTT_MAX_ENDPOINTS];
+    uint8_t endpoint_count;
+    int active_endpoint;
+    bool connecting;        // Attempt in progress, including its DNS lookup
+    bool resolving;         // Waiting for the broker's DNS lookup
+    uint8_t resolve_seq;    // Tags the lookup in flight (stale answers are ignored)
+    bool session_up;
+    unsigned long connect_started;
+
+    // Set from the async TCP task, handled in loop()
+    volatile bool connect_event;
+    volatile bool disconnect_event;
+    volatile unsigned long connect_event_ms;
+
+    // Bootstrap state (written from the async TCP task)
+    char client_id[32];
+    MQTTBootstrapStats bootstrap_stats;
+    uint32_t received_mask;       // Live topics seen since the connect
+    uint32_t filled_mask;         // Live or companion
+    uint32_t subscribed_signature;
+    unsigned long companion_published_at[TOPIC_COUNT];
+
+    // Ingest slots, filled by the async TCP task and drained in loop()
+    struct IngestSlot {
+        char payload[MAX_MQTT_MESSAGE_SIZE + 1];
+        bool companion;
+    };
+    IngestSlot ingest_slots[MQTT_INGEST_CHANNELS];
+    volatile uint32_t ingest_pending_mask;
+    uint8_t ingest_next_channel;
+    float ingest_tokens;
+    unsigned long ingest_refill_ms;
+    MQTTIngestStats ingest_stats;
     
     // Callbacks for data updates
     void (*solarCallback)(float);
@@ -79,6 +213,30 @@ private:
     void (*evSOCCallback)(float);
     float last_ev_power;  // Store for home subtraction
 
+    // Extra flow nodes
+    MQTTExtraNode extra_node_list[MQTT_MAX_EXTRA_NODES];
+    uint8_t extra_node_count;
+    void (*extraNodeCallback)(uint8_t, float);
+
+    void rebuildEndpoints();
+    void rebuildExtraNodes();
+    float chargerPower();
+    void applyClientOptions();
+    uint32_t subscriptionSignature();
+    void publishCompanion(PowerwallTopic topic, const char *message);
+    void processIngest();
+    void processMessage(uint8_t channel, const char *message, bool is_companion);
+    int selectEndpoint();
+    bool endpointResolved(const MQTTEndpoint &endpoint);
+    void startAttempt();
+    void finishResolve(uint32_t addr);
+    void connectEndpoint(MQTTEndpoint &endpoint);
+    void cancelAttempt();
+    void onAttemptFailed();
+    void scheduleAttempt(unsigned long delay_ms);
+    void handleConnected();
+    void handleDisconnected();
+
     void onMqttConnect(bool sessionPresent);
     void onMqttDisconnect(AsyncMqttClientDisconnectReason reason);
     void onMqttMessage(char* topic, char* payload, AsyncMqttClientMessageProperties properties, size_t len, size_t index, size_t total);
@@ -5,6 +5,7 @@
 
 // Create MQTT config screen as overlay on parent
 void createMqttConfigScreen(lv_obj_t *parent_screen);
+void destroyMqttConfigScreen();
 
 // Show/hide MQTT config screen with QR code to web server
 void showMqttConfigScreen(const char* ip_address);
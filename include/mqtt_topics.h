@@ -0,0 +1,30 @@
+#ifndef MQTT_TOPICS_H
+#define MQTT_TOPICS_H
+
+#include <Arduino.h>
+
+// pypowerwall topics, relative to the configured prefix. New metrics only
+// need an entry here and a case in the client's dispatch.
+
+enum PowerwallTopic : uint8_t {
+    TOPIC_SOLAR = 0,
+    TOPIC_GRID,
+    TOPIC_HOME,
+    TOPIC_BATTERY,
+    TOPIC_SOC,
+    TOPIC_OFFGRID,
+    TOPIC_TIME_REMAINING,
+    TOPIC_COUNT,
+    TOPIC_UNKNOWN = 0xFF
+};
+
+// Suffix of a topic under the prefix (e.g. "battery/level")
+const char* getPowerwallTopicSuffix(PowerwallTopic topic);
+
+// Match the part of a topic after the prefix; TOPIC_UNKNOWN if it isn't ours
+PowerwallTopic matchPowerwallTopic(const char *suffix);
+
+// MQTT filter matching with '+' and '#' wildcards
+bool mqttTopicMatchesFilter(const char *filter, const char *topic);
+
+#endif // MQTT_TOPICS_H
@@ -0,0 +1,52 @@
+#ifndef NETWORK_RECOVERY_H
+#define NETWORK_RECOVERY_H
+
+#include <Arduino.h>
+
+// Escalating recovery from network outages. An outage starts when WiFi or
+// (if configured) MQTT drops after having been up. Each step fires at most
+// once per outage, once its delay from the start has passed and it applies
+// (a step that doesn't apply yet stays pending):
+//   reconnect  - normal WiFi/MQTT retries (immediate)
+//   wifi_reset - restart the WiFi driver and netif (WiFi still down)
+//   mqtt_reinit - rebuild the MQTT client session (WiFi up, MQTT down)
+//   reboot     - last resort (WiFi still down)
+// A broker-only outage never reboots the device.
+
+#define NET_RECOVERY_WIFI_RESET_MS   60000   // 1 minute
+#define NET_RECOVERY_MQTT_REINIT_MS  120000  // 2 minutes
+#define NET_RECOVERY_REBOOT_MS       300000  // 5 minutes
+// Time for the log to flush before the reboot
+#define NET_RECOVERY_REBOOT_DELAY    1000
+
+enum RecoveryStep : uint8_t {
+    RECOVERY_RECONNECT = 0,
+    RECOVERY_WIFI_RESET,
+    RECOVERY_MQTT_REINIT,
+    RECOVERY_REBOOT,
+    RECOVERY_STEP_COUNT
+};
+
+struct RecoveryStepStats {
+    uint32_t runs;
+    uint32_t recoveries;        // Outages that ended while this was the latest step
+    uint32_t last_recovery_ms;  // Step run -> healthy again
+};
+
+struct NetworkRecoveryStats {
+    bool in_outage;
+    RecoveryStep step;           // Latest step run in the current/last outage
+    uint32_t outages;
+    uint32_t last_outage_ms;
+    uint32_t longest_outage_ms;
+    uint32_t recovery_reboots;   // Kept across the reboot itself
+    RecoveryStepStats steps[RECOVERY_STEP_COUNT];
+};
+
+// Call from loop() after checkWiFiConnection() and mqttClient.loop()
+void loopNetworkRecovery();
+
+const NetworkRecoveryStats& getNetworkRecoveryStats();
+const char* getRecoveryStepName(RecoveryStep step);
+
+#endif // NETWORK_RECOVERY_H
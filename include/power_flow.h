@@ -0,0 +1,74 @@
+#ifndef POWER_FLOW_H
+#define POWER_FLOW_H
+
+// Visual power-flow allocation over a small energy topology: a node list
+// (solar, generators, grid, batteries, home, EV chargers) and a solver that
+// decides which source feeds which sink. Pure math (no LVGL, no allocation),
+// so it runs per animation frame and builds natively.
+
+#include <stdint.h>
+
+// Flows below this are not drawn
+#define POWER_FLOW_THRESHOLD_W 50.0f
+// Solar does not charge a battery at or above this SOC
+#define POWER_FLOW_BATTERY_FULL_SOC 99.5f
+
+#define POWER_FLOW_MAX_NODES 10
+#define POWER_FLOW_MAX_EDGES 24  // Each source/sink match exhausts one side, so 2x nodes is plenty
+#define POWER_NODE_NONE 0xFF
+
+enum PowerNodeRole : uint8_t {
+    NODE_SOLAR = 0,  // Source
+    NODE_GENERATOR,  // Source
+    NODE_GRID,       // Source (import) or sink (export)
+    NODE_BATTERY,    // Source (discharge) or sink (charge)
+    NODE_HOME,       // Sink
+    NODE_EV,         // Drawn from its feeder node; not part of the home reading
+    NODE_ROLE_COUNT
+};
+
+struct PowerNode {
+    PowerNodeRole role;
+    float w;         // pypowerwall signs: grid > 0 imports, battery > 0 discharges; others >= 0
+    float soc;       // Batteries only
+    uint8_t feeder;  // EV only: node the charger is supplied through (home)
+};
+
+struct PowerTopology {
+    PowerNode nodes[POWER_FLOW_MAX_NODES];
+    uint8_t count;
+};
+
+struct PowerFlow {
+    uint8_t from;
+    uint8_t to;
+    float w;  // > 0
+};
+
+struct PowerFlowResult {
+    PowerFlow flows[POWER_FLOW_MAX_EDGES];
+    uint8_t count;
+    float max_active;  // Largest flow >= POWER_FLOW_THRESHOLD_W, else 0
+};
+
+// Append a node (w and soc start at 0); POWER_NODE_NONE when the topology is full
+uint8_t addPowerNode(PowerTopology &topology, PowerNodeRole role, uint8_t feeder = POWER_NODE_NONE);
+
+// Sources in order solar, generator, grid, battery; each fills its sinks by
+// priority: solar -> battery (unless full), home, grid; generator -> home,
+// battery; grid -> battery, home; battery -> home, grid. Nodes of one role
+// are served in list order. EV chargers get one edge from their feeder.
+void solvePowerFlows(const PowerTopology &topology, PowerFlowResult &result);
+
+// Whether the solver may route power from one role to another (EV excluded)
+bool canPowerFlow(PowerNodeRole from, PowerNodeRole to);
+
+// "solar", "generator", ...; parsePowerNodeRole returns NODE_ROLE_COUNT if unknown
+const char* getPowerNodeRoleName(PowerNodeRole role);
+PowerNodeRole parsePowerNodeRole(const char *name);
+
+inline bool isPowerFlowActive(float watts) {
+    return watts >= POWER_FLOW_THRESHOLD_W;
+}
+
+#endif // POWER_FLOW_H
@@ -9,6 +9,28 @@
 #define DEFAULT_NTP_SERVER "pool.ntp.org"
 #define DEFAULT_TIMEZONE "UTC0"  // UTC with no DST
 
+// SNTP keeps resyncing in the background at this interval
+#define TIME_RESYNC_INTERVAL_MS 3600000  // 1 hour
+// A sync that hasn't completed by then is reported as failed (SNTP keeps retrying)
+#define TIME_SYNC_TIMEOUT_MS 30000
+
+enum TimeSyncState : uint8_t {
+    TIME_SYNC_IDLE = 0,   // NTP disabled or not started
+    TIME_SYNC_PENDING,    // Waiting for the first response
+    TIME_SYNC_SYNCED,
+    TIME_SYNC_FAILED      // Timed out, still retrying in the background
+};
+
+struct TimeSyncStats {
+    TimeSyncState state;
+    uint32_t sync_count;
+    uint32_t fail_count;
+    uint32_t last_sync_ms;       // millis() of the last successful sync
+    uint32_t last_duration_ms;   // Request to first response
+    int32_t last_drift_ms;       // Clock error corrected by the last resync
+    float drift_ppm;
+};
+
 struct TimeConfig {
     String ntpServer = DEFAULT_NTP_SERVER;
     String timezone = DEFAULT_TIMEZONE;  // POSIX timezone string (e.g., "PST8PDT,M3.2.0,M11.1.0")
@@ -19,14 +41,17 @@ class TimeConfigManager {
 public:
     TimeConfigManager();
 
-    void begin();
+    void begin();  // Load config only, does not sync
     void saveConfig();
     
     TimeConfig& getConfig();
     
-    // NTP synchronization
+    // NTP synchronization (non-blocking, progress is driven by loop())
     void syncTime();
+    void loop();
     bool isTimeSynced();
+    void setSyncCallback(void (*callback)(bool success));
+    const TimeSyncStats& getSyncStats();
     
     // Get current local time
     bool getLocalTime(struct tm *timeinfo);
@@ -36,6 +61,19 @@ private:
     TimeConfig config;
     Preferences preferences;
     bool timeSynced = false;
+
+    TimeSyncStats stats = {};
+    volatile bool syncRequested = false;
+    unsigned long syncStartMs = 0;
+    void (*syncCallback)(bool success) = nullptr;
+
+    // Previous sync, for drift: wall clock vs. the monotonic timer
+    int64_t lastSyncEpochUs = 0;
+    int64_t lastSyncTimerUs = 0;
+
+    void startSync();
+    void handleSyncEvent();
+    void notifySync(bool success);
 };
 
 extern TimeConfigManager timeConfig;
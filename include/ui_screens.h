@@ -0,0 +1,8 @@
+#ifndef UI_SCREENS_H
+#define UI_SCREENS_H
+
+// Builds the UI shared by the firmware and the native build: styles, glyph
+// cache, the dashboard and the lazily created secondary screens.
+void createScreens();
+
+#endif // UI_SCREENS_H
@@ -0,0 +1,62 @@
+#ifndef UI_STYLES_H
+#define UI_STYLES_H
+
+#include <lvgl.h>
+
+// Shared, statically allocated styles. Objects reference these with
+// lv_obj_add_style() instead of each carrying its own local style list.
+
+// Screens and full-screen overlays
+extern lv_style_t ui_style_screen;
+extern lv_style_t ui_style_overlay;
+
+// Text
+extern lv_style_t ui_style_title;        // White, 24px
+extern lv_style_t ui_style_header;       // Gray, 16px
+extern lv_style_t ui_style_info_value;   // White, 16px (OK/error colors via LV_STATE_USER_1)
+extern lv_style_t ui_style_status_ok;
+extern lv_style_t ui_style_status_error;
+extern lv_style_t ui_style_url;          // 20px, color set per screen
+extern lv_style_t ui_style_message;      // Gray, 20px, centered
+
+// Buttons
+extern lv_style_t ui_style_btn;          // Radius 8
+extern lv_style_t ui_style_btn_dark;
+extern lv_style_t ui_style_btn_warning;
+extern lv_style_t ui_style_btn_danger;
+extern lv_style_t ui_style_btn_label;    // White, default font
+extern lv_style_t ui_style_btn_label_16; // White, 16px
+
+// Main dashboard
+extern lv_style_t ui_style_value_label;  // White, centered
+extern lv_style_t ui_style_align_left;
+extern lv_style_t ui_style_align_right;
+extern lv_style_t ui_style_ev_soc;
+extern lv_style_t ui_style_dot;          // Flow dot shape (color from a dot color style)
+extern lv_style_t ui_style_dot_solar;
+extern lv_style_t ui_style_dot_grid;
+extern lv_style_t ui_style_dot_battery;
+extern lv_style_t ui_style_dot_ev;
+extern lv_style_t ui_style_dot_generator;
+extern lv_style_t ui_style_dot_rx;
+extern lv_style_t ui_style_node_badge;   // Round badge for nodes without an icon (border from a badge color style)
+extern lv_style_t ui_style_badge_generator;
+extern lv_style_t ui_style_badge_battery;
+extern lv_style_t ui_style_badge_ev;
+extern lv_style_t ui_style_bar_main;
+extern lv_style_t ui_style_bar_indicator;
+extern lv_style_t ui_style_stale;        // Dimmed text for restored, not yet refreshed values
+
+// State used to switch info values to the OK color (default is the error color)
+#define UI_STATE_OK LV_STATE_USER_1
+
+// State used to dim dashboard values restored from the last session
+#define UI_STATE_STALE LV_STATE_USER_2
+
+// Initialize all shared styles (call once after lv_init, before creating screens)
+void initUIStyles();
+
+// Print LVGL heap usage with a tag, returns bytes in use
+uint32_t logLvglMemory(const char *tag);
+
+#endif // UI_STYLES_H
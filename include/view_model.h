@@ -0,0 +1,38 @@
+#ifndef VIEW_MODEL_H
+#define VIEW_MODEL_H
+
+#include <lvgl.h>
+
+#define VIEW_TEXT_MAX 40
+
+// Last output pushed to one widget. LVGL is only called when a new
+// value differs, so repeated identical MQTT values cause no invalidation.
+struct WidgetView {
+    lv_obj_t *obj = nullptr;
+    bool text_valid = false;
+    bool opa_valid = false;
+    bool hidden_valid = false;
+    bool hidden = false;
+    lv_opa_t opa = LV_OPA_COVER;
+    char text[VIEW_TEXT_MAX] = {0};
+};
+
+struct ViewStats {
+    uint32_t applied;     // Updates that reached LVGL
+    uint32_t suppressed;  // Updates skipped because output was unchanged
+};
+
+// Attach a view to its widget (resets the cached state)
+void viewBind(WidgetView &view, lv_obj_t *obj);
+
+// Text setters for lv_label and glyph label widgets
+void viewSetLabelText(WidgetView &view, const char *text);
+void viewSetGlyphText(WidgetView &view, const char *text, const char *accent = nullptr);
+
+// Object opacity (lv_obj_set_style_opa) and LV_OBJ_FLAG_HIDDEN
+void viewSetOpa(WidgetView &view, lv_opa_t opa);
+void viewSetHidden(WidgetView &view, bool hidden);
+
+const ViewStats& getViewStats();
+
+#endif // VIEW_MODEL_H
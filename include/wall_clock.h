@@ -0,0 +1,33 @@
+#ifndef WALL_CLOCK_H
+#define WALL_CLOCK_H
+
+#include <Arduino.h>
+#include <time.h>
+
+// Local time computed once per second and cached. Consumers read the cached
+// fields or subscribe to minute/hour changes instead of calling localtime.
+
+#define WALL_CLOCK_MAX_LISTENERS 4
+
+typedef void (*WallClockListener)(const struct tm &now);
+
+// Refresh the cache when the second changes (call from loop)
+void updateWallClock();
+
+// False until the clock has been set (NTP)
+bool wallClockValid();
+
+// Cached local time (only meaningful while wallClockValid())
+const struct tm& getWallClock();
+
+// -1 while the clock is invalid
+int wallClockHour();
+int wallClockMinute();
+
+// Called from updateWallClock() when the minute/hour changes, including the
+// moment the clock first becomes valid or the timezone changes the hour, and
+// once when it becomes invalid again (tm_hour and tm_min are -1 then)
+bool onWallClockMinute(WallClockListener listener);
+bool onWallClockHour(WallClockListener listener);
+
+#endif // WALL_CLOCK_H
@@ -17,6 +17,7 @@ public:
     PowerwallWebServer();
     
     void begin();
+    void loop();  // Publishes the /api/stats snapshot (call from loop())
     
 private:
     AsyncWebServer server;
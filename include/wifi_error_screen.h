@@ -5,6 +5,7 @@
 
 // Create WiFi error screen as overlay on parent
 void createWifiErrorScreen(lv_obj_t *parent_screen);
+void destroyWifiErrorScreen();
 
 // Show/hide WiFi error screen
 void showWifiErrorScreen(const char* message);
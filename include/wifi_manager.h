@@ -0,0 +1,103 @@
+#ifndef WIFI_MANAGER_H
+#define WIFI_MANAGER_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <Preferences.h>
+
+// Station connection state machine. Driver events (WiFi.onEvent) are queued
+// from the WiFi event task and handled in checkWiFiConnection() on the loop
+// task, which also owns all timeouts. Nothing here blocks.
+
+// WiFi connection timeout
+#define WIFI_CONNECT_TIMEOUT 30000
+// WiFi reconnection delay (retry every 10 seconds); the first retry after a drop is immediate
+#define WIFI_RECONNECT_DELAY 10000
+// Fast connect (cached BSSID/channel) gives up sooner and falls back to a full scan
+#define WIFI_FAST_CONNECT_TIMEOUT 5000
+// Fast connects reuse the cached DHCP lease this many times before asking the server again
+#define WIFI_LEASE_MAX_REUSES 8
+
+enum WiFiState : uint8_t {
+    WIFI_STATE_IDLE = 0,     // No connection requested
+    WIFI_STATE_ASSOCIATING,  // WiFi.begin() issued, waiting for the AP
+    WIFI_STATE_DHCP,         // Associated, waiting for an address
+    WIFI_STATE_CONNECTED,
+    WIFI_STATE_WAIT_RETRY    // Attempt failed or link dropped, retry pending
+};
+
+struct WiFiStats {
+    WiFiState state;
+    uint32_t connect_attempts;
+    uint32_t connects;
+    uint32_t disconnects;
+    uint8_t last_disconnect_reason;  // wifi_err_reason_t
+    uint32_t last_associate_ms;      // begin() -> associated
+    uint32_t last_dhcp_ms;           // associated -> got IP
+    uint32_t last_reconnect_ms;      // link lost -> got IP
+    uint32_t connected_since_ms;     // millis() of the last connect, 0 if not connected
+    uint32_t fast_attempts;          // Attempts using the cached BSSID/channel
+    uint32_t fast_connects;
+    uint32_t lease_connects;         // Fast connects that reused the cached lease (no DHCP)
+    bool last_attempt_fast;
+    bool last_attempt_lease;
+};
+
+// Optional static addressing (skips DHCP); stored in the "wifi" namespace
+struct WiFiNetworkConfig {
+    bool static_ip = false;
+    IPAddress ip;
+    IPAddress gateway;
+    IPAddress subnet;
+    IPAddress dns;
+};
+
+// Details of the last successful connection, used for the fast path
+struct WiFiConnectionCache {
+    bool valid = false;
+    uint8_t bssid[6] = {0};
+    uint8_t channel = 0;
+    IPAddress lease_ip;      // Last DHCP lease, reused by the fast path
+    IPAddress lease_gateway;
+    IPAddress lease_subnet;
+    IPAddress lease_dns;
+};
+
+// Station mode and event handlers (call once before connecting)
+void setupWiFi();
+
+// WiFi connection management
+void connectToWiFi(const char* ssid, const char* password);
+void checkWiFiConnection();
+String getLocalIP();
+
+// Retry WiFi connection with saved credentials
+void retryWiFiConnection();
+
+// Restart the WiFi driver and netif, then reconnect (network recovery)
+void resetWiFiDriver();
+
+// Get next WiFi retry time (for countdown display), 0 if none is scheduled
+unsigned long getNextWiFiRetryTime();
+
+// Check if WiFi credentials are saved
+bool hasWifiCredentials();
+bool loadWiFiCredentials(String &ssid, String &password);
+void saveWiFiCredentials(const char *ssid, const char *password);
+
+// Static IP settings take effect on the next connection attempt
+WiFiNetworkConfig& getWiFiNetworkConfig();
+void saveWiFiNetworkConfig();
+const WiFiConnectionCache& getWiFiConnectionCache();
+
+bool isWiFiConnecting();
+const WiFiStats& getWiFiStats();
+const char* getWiFiStateName(WiFiState state);
+
+// Result of each connection attempt (used by Improv provisioning)
+void setWiFiResultCallback(void (*callback)(bool connected));
+
+// Preferences for storing WiFi credentials
+extern Preferences wifi_preferences;
+
+#endif // WIFI_MANAGER_H
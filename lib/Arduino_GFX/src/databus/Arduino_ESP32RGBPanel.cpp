@@ -261,6 +261,31 @@ uint16_t *Arduino_ESP32RGBPanel::getFrameBuffer(
   return (uint16_t *)_rgb_panel->fb;
 }
 
+void Arduino_ESP32RGBPanel::stopScanout()
+{
+  if (!_rgb_panel)
+  {
+    return;
+  }
+  lcd_ll_stop(_rgb_panel->hal.dev);
+  gdma_stop(_rgb_panel->dma_chan);
+}
+
+void Arduino_ESP32RGBPanel::startScanout()
+{
+  if (!_rgb_panel)
+  {
+    return;
+  }
+  // Same sequence as esp_lcd's start transmission: restart from the top of the frame buffer
+  gdma_reset(_rgb_panel->dma_chan);
+  lcd_ll_stop(_rgb_panel->hal.dev);
+  lcd_ll_fifo_reset(_rgb_panel->hal.dev);
+  gdma_start(_rgb_panel->dma_chan, (intptr_t)_rgb_panel->dma_nodes);
+  delayMicroseconds(1);
+  lcd_ll_start(_rgb_panel->hal.dev);
+}
+
 INLINE void Arduino_ESP32RGBPanel::CS_HIGH(void)
 {
   *_csPortSet = _csPinMask;
@@ -0,0 +1,52 @@
+#include "boot_timeline.h"
+
+static BootStage boot_stages[BOOT_TIMELINE_MAX_STAGES];
+static uint8_t boot_stage_count = 0;
+static uint32_t boot_last_mark_ms = 0;
+static uint32_t boot_first_frame_ms = 0;
+static uint32_t boot_ready_ms = 0;
+
+void markBootStage(const char *name) {
+    const uint32_t now = millis();
+    const uint32_t duration = now - boot_last_mark_ms;
+    boot_last_mark_ms = now;
+
+    Serial.printf("Boot: %s done at %lu ms (+%lu ms)\n", name,
+                  (unsigned long)now, (unsigned long)duration);
+
+    if (boot_stage_count >= BOOT_TIMELINE_MAX_STAGES) return;
+    BootStage &stage = boot_stages[boot_stage_count++];
+    stage.name = name;
+    stage.end_ms = now;
+    stage.duration_ms = duration;
+}
+
+void markBootFirstFrame() {
+    if (boot_first_frame_ms != 0) return;
+    markBootStage("first_frame");
+    boot_first_frame_ms = boot_last_mark_ms;
+}
+
+void markBootComplete() {
+    if (boot_ready_ms != 0) return;
+    markBootStage("ready");
+    boot_ready_ms = boot_last_mark_ms;
+}
+
+uint8_t getBootStageCount() {
+    return boot_stage_count;
+}
+
+const BootStage& getBootStage(uint8_t index) {
+    static const BootStage empty = {"", 0, 0};
+    if (index >= boot_stage_count) return empty;
+    return boot_stages[index];
+}
+
+uint32_t getBootFirstFrameMs() {
+    return boot_first_frame_ms;
+}
+
+uint32_t getBootReadyMs() {
+    return boot_ready_ms;
+}
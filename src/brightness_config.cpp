@@ -17,6 +17,9 @@ void BrightnessConfigManager::begin() {
     config.nightIdleDimmingEnabled = preferences.getBool("nightIdleEn", false);
     config.idleTimeout = static_cast<IdleTimeout>(preferences.getUChar("idleTimeout", IDLE_NEVER));
     config.idleBrightness = preferences.getUChar("idleBright", 80);
+    config.sleepMode = static_cast<SleepMode>(preferences.getUChar("sleepMode", SLEEP_NEVER));
+    config.sleepTimeout = preferences.getUShort("sleepTimeout", 300);
+    config.wakeOnOffGrid = preferences.getBool("wakeOffGrid", true);
     
     preferences.end();
 }
@@ -32,6 +35,9 @@ void BrightnessConfigManager::saveConfig() {
     preferences.putBool("nightIdleEn", config.nightIdleDimmingEnabled);
     preferences.putUChar("idleTimeout", static_cast<uint8_t>(config.idleTimeout));
     preferences.putUChar("idleBright", config.idleBrightness);
+    preferences.putUChar("sleepMode", static_cast<uint8_t>(config.sleepMode));
+    preferences.putUShort("sleepTimeout", config.sleepTimeout);
+    preferences.putBool("wakeOffGrid", config.wakeOnOffGrid);
     
     preferences.end();
 }
@@ -4,10 +4,16 @@
 BrightnessController brightnessController;
 
 BrightnessController::BrightnessController() 
-    : currentBrightness(100), targetBrightness(100), lastTouchTime(0), isDimmedByIdle(false) {
+    : currentBrightness(100), targetBrightness(100), lastTouchTime(0), isDimmedByIdle(false), currentHour(-1),
+      asleep(false), sleepForced(false), wakeRequested(false), sleepRequested(false), sleepCallback(nullptr) {
 }
 
 void BrightnessController::begin() {
+    // Day/night follows the cached wall clock (hour -1 once it is lost, which
+    // means no schedule); update() applies the change
+    onWallClockHour([](const struct tm &now) { brightnessController.onHourChanged(now.tm_hour); });
+    currentHour = wallClockHour();
+
     // Configure PWM for backlight control
     ledcSetup(PWM_CHANNEL, PWM_FREQ, PWM_RESOLUTION);
     ledcAttachPin(BACKLIGHT_PIN, PWM_CHANNEL);
@@ -22,6 +28,33 @@ void BrightnessController::begin() {
 }
 
 void BrightnessController::update() {
+    // Requests from the web server and MQTT events
+    if (wakeRequested) {
+        wakeRequested = false;
+        lastTouchTime = millis();
+        exitSleep();
+    }
+    if (sleepRequested) {
+        sleepRequested = false;
+        if (!asleep) {
+            enterSleep();
+            sleepForced = true;
+        }
+    }
+
+    // Scheduled sleep ends by itself (day starts, brightness back above 0);
+    // a requested sleep lasts until touched or woken
+    if (asleep) {
+        if (!sleepForced && !shouldSleep()) {
+            exitSleep();
+        }
+        return;
+    }
+    if (shouldSleep()) {
+        enterSleep();
+        return;
+    }
+
     // Update scheduled brightness based on time of day
     uint8_t scheduledBrightness = getScheduledBrightness();
     
@@ -61,8 +94,19 @@ uint8_t BrightnessController::getCurrentBrightness() {
     return currentBrightness;
 }
 
-void BrightnessController::onTouchDetected() {
+bool BrightnessController::isDimmed() {
+    return isDimmedByIdle || currentBrightness < brightnessConfig.getConfig().dayBrightness;
+}
+
+bool BrightnessController::onTouchDetected() {
     lastTouchTime = millis();
+
+    // A touch on a sleeping display only wakes it. Touch is read inside
+    // lv_timer_handler(), so the wake (which renders a frame) runs from update().
+    if (asleep) {
+        wakeRequested = true;
+        return true;
+    }
     
     // If we were dimmed by idle, restore brightness immediately
     if (isDimmedByIdle) {
@@ -71,6 +115,47 @@ void BrightnessController::onTouchDetected() {
         isDimmedByIdle = false;
         Serial.printf("Touch detected - restoring brightness to %d%%\n", scheduledBrightness);
     }
+    return false;
+}
+
+void BrightnessController::setSleepCallback(void (*callback)(bool asleep)) {
+    sleepCallback = callback;
+}
+
+bool BrightnessController::isAsleep() {
+    return asleep;
+}
+
+void BrightnessController::requestWake() {
+    wakeRequested = true;
+}
+
+void BrightnessController::requestSleep() {
+    sleepRequested = true;
+}
+
+void BrightnessController::enterSleep() {
+    // Backlight off first so the panel shutdown is never visible
+    applyBrightness(0);
+    isDimmedByIdle = false;
+    asleep = true;
+    if (sleepCallback) sleepCallback(true);
+    Serial.println("Display sleeping");
+}
+
+void BrightnessController::exitSleep() {
+    if (!asleep) return;
+
+    // Nothing to show at 0%, stay asleep
+    uint8_t scheduledBrightness = getScheduledBrightness();
+    if (scheduledBrightness == 0) return;
+
+    // The callback draws the first frame before the backlight comes back
+    asleep = false;
+    sleepForced = false;
+    if (sleepCallback) sleepCallback(false);
+    applyBrightness(scheduledBrightness);
+    Serial.printf("Display awake at %d%%\n", scheduledBrightness);
 }
 
 void BrightnessController::applyBrightness(uint8_t brightness) {
@@ -81,12 +166,13 @@ void BrightnessController::applyBrightness(uint8_t brightness) {
     ledcWrite(PWM_CHANNEL, pwmValue);
 }
 
+void BrightnessController::onHourChanged(int hour) {
+    currentHour = hour;
+}
+
 uint8_t BrightnessController::getScheduledBrightness() {
     BrightnessConfig& config = brightnessConfig.getConfig();
     
-    // Get current hour from time config
-    int currentHour = timeConfig.getCurrentHour();
-    
     // If time not available, default to day brightness
     if (currentHour < 0) {
         return config.dayBrightness;
@@ -98,9 +184,6 @@ uint8_t BrightnessController::getScheduledBrightness() {
 bool BrightnessController::isDayTime() {
     BrightnessConfig& config = brightnessConfig.getConfig();
     
-    // Get current hour from time config
-    int currentHour = timeConfig.getCurrentHour();
-    
     // If time not available, default to day mode
     if (currentHour < 0) {
         return true;
@@ -134,3 +217,19 @@ bool BrightnessController::shouldDimForIdle() {
     
     return timeSinceTouch >= idleTimeMs;
 }
+
+bool BrightnessController::shouldSleep() {
+    BrightnessConfig& config = brightnessConfig.getConfig();
+
+    // Nothing is visible at 0%, so don't keep rendering
+    if (getScheduledBrightness() == 0 || (config.idleBrightness == 0 && shouldDimForIdle())) {
+        return true;
+    }
+
+    bool sleepEnabled = config.sleepMode == SLEEP_ALWAYS || (config.sleepMode == SLEEP_NIGHT && !isDayTime());
+    if (!sleepEnabled || config.sleepTimeout == 0) {
+        return false;
+    }
+
+    return millis() - lastTouchTime >= config.sleepTimeout * 1000UL;
+}
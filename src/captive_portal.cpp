@@ -1,5 +1,5 @@
 #include "captive_portal.h"
-#include "improv_wifi.h"
+#include "wifi_manager.h"
 #include <WiFi.h>
 #include <DNSServer.h>
 #include <ESPAsyncWebServer.h>
@@ -92,10 +92,7 @@ void startCaptivePortal() {
                 Serial.printf("Captive portal: saving credentials for '%s'\n", ssid.c_str());
 
                 // Save credentials
-                wifi_preferences.begin("wifi", false);
-                wifi_preferences.putString("ssid", ssid);
-                wifi_preferences.putString("password", password);
-                wifi_preferences.end();
+                saveWiFiCredentials(ssid.c_str(), password.c_str());
 
                 request->send(200, "application/json", "{\"status\":\"ok\",\"message\":\"Credentials saved. Restarting...\"}");
 
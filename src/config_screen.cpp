@@ -1,15 +1,14 @@
 #include "config_screen.h"
 #include "info_screen.h"
-#include "improv_wifi.h"
+#include "wifi_manager.h"
+#include "ui_styles.h"
+#include "lazy_screens.h"
 #include <WiFi.h>
 
 // Theme colors (matching main screen)
 #define COLOR_BG        0x0A0C10
 #define COLOR_WHITE     0xFFFFFF
-#define COLOR_GRAY      0x6A6A6A
 #define COLOR_CYAN      0x4FC3F7
-#define COLOR_RED       0xEF4444
-#define COLOR_ORANGE    0xF59E0B
 
 // Display dimensions
 #define TFT_WIDTH 480
@@ -32,34 +31,32 @@ static void clear_wifi_btn_event_cb(lv_event_t *e);
 void createConfigScreen() {
     // Create config screen
     config_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(config_screen, lv_color_hex(COLOR_BG), 0);
+    lv_obj_add_style(config_screen, &ui_style_screen, 0);
     lv_obj_clear_flag(config_screen, LV_OBJ_FLAG_SCROLLABLE);
 
     // Title
     lv_obj_t *title = lv_label_create(config_screen);
     lv_label_set_text(title, "Web Configuration");
-    lv_obj_set_style_text_color(title, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_24, 0);
+    lv_obj_add_style(title, &ui_style_title, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 30);
 
     // Back button
     lv_obj_t *btn_back = lv_btn_create(config_screen);
     lv_obj_set_size(btn_back, 80, 40);
     lv_obj_align(btn_back, LV_ALIGN_TOP_LEFT, 20, 20);
-    lv_obj_set_style_bg_color(btn_back, lv_color_hex(0x2A2D32), 0);
-    lv_obj_set_style_radius(btn_back, 8, 0);
+    lv_obj_add_style(btn_back, &ui_style_btn, 0);
+    lv_obj_add_style(btn_back, &ui_style_btn_dark, 0);
     lv_obj_add_event_cb(btn_back, back_btn_event_cb, LV_EVENT_CLICKED, NULL);
 
     lv_obj_t *btn_label = lv_label_create(btn_back);
     lv_label_set_text(btn_label, "< Back");
-    lv_obj_set_style_text_color(btn_label, lv_color_hex(COLOR_WHITE), 0);
+    lv_obj_add_style(btn_label, &ui_style_btn_label, 0);
     lv_obj_center(btn_label);
 
     // Instructions
     lv_obj_t *instructions = lv_label_create(config_screen);
     lv_label_set_text(instructions, "Scan to open settings in browser");
-    lv_obj_set_style_text_color(instructions, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(instructions, &lv_font_montserrat_16, 0);
+    lv_obj_add_style(instructions, &ui_style_header, 0);
     lv_obj_align(instructions, LV_ALIGN_TOP_MID, 0, 80);
 
     // QR code (created but hidden initially)
@@ -70,17 +67,15 @@ void createConfigScreen() {
     // URL label below QR code
     lbl_url = lv_label_create(config_screen);
     lv_label_set_text(lbl_url, "");
+    lv_obj_add_style(lbl_url, &ui_style_url, 0);
     lv_obj_set_style_text_color(lbl_url, lv_color_hex(COLOR_CYAN), 0);
-    lv_obj_set_style_text_font(lbl_url, &lv_font_montserrat_20, 0);
     lv_obj_align(lbl_url, LV_ALIGN_CENTER, 0, QR_SIZE / 2 + 30);
     lv_obj_add_flag(lbl_url, LV_OBJ_FLAG_HIDDEN);
 
     // No WiFi message (shown when not connected)
     lbl_no_wifi = lv_label_create(config_screen);
     lv_label_set_text(lbl_no_wifi, "WiFi not connected\n\nConnect to WiFi first\nto access web configuration");
-    lv_obj_set_style_text_color(lbl_no_wifi, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(lbl_no_wifi, &lv_font_montserrat_20, 0);
-    lv_obj_set_style_text_align(lbl_no_wifi, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_add_style(lbl_no_wifi, &ui_style_message, 0);
     lv_obj_align(lbl_no_wifi, LV_ALIGN_CENTER, 0, 0);
     lv_obj_add_flag(lbl_no_wifi, LV_OBJ_FLAG_HIDDEN);
 
@@ -88,28 +83,26 @@ void createConfigScreen() {
     lv_obj_t *btn_clear_wifi = lv_btn_create(config_screen);
     lv_obj_set_size(btn_clear_wifi, 140, 45);
     lv_obj_align(btn_clear_wifi, LV_ALIGN_BOTTOM_MID, -80, -30);
-    lv_obj_set_style_bg_color(btn_clear_wifi, lv_color_hex(COLOR_ORANGE), 0);
-    lv_obj_set_style_radius(btn_clear_wifi, 8, 0);
+    lv_obj_add_style(btn_clear_wifi, &ui_style_btn, 0);
+    lv_obj_add_style(btn_clear_wifi, &ui_style_btn_warning, 0);
     lv_obj_add_event_cb(btn_clear_wifi, clear_wifi_btn_event_cb, LV_EVENT_CLICKED, NULL);
 
     lv_obj_t *clear_wifi_label = lv_label_create(btn_clear_wifi);
     lv_label_set_text(clear_wifi_label, "Clear WiFi");
-    lv_obj_set_style_text_color(clear_wifi_label, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(clear_wifi_label, &lv_font_montserrat_16, 0);
+    lv_obj_add_style(clear_wifi_label, &ui_style_btn_label_16, 0);
     lv_obj_center(clear_wifi_label);
 
     // Restart button at bottom right
     lv_obj_t *btn_restart = lv_btn_create(config_screen);
     lv_obj_set_size(btn_restart, 120, 45);
     lv_obj_align(btn_restart, LV_ALIGN_BOTTOM_MID, 80, -30);
-    lv_obj_set_style_bg_color(btn_restart, lv_color_hex(COLOR_RED), 0);
-    lv_obj_set_style_radius(btn_restart, 8, 0);
+    lv_obj_add_style(btn_restart, &ui_style_btn, 0);
+    lv_obj_add_style(btn_restart, &ui_style_btn_danger, 0);
     lv_obj_add_event_cb(btn_restart, restart_btn_event_cb, LV_EVENT_CLICKED, NULL);
 
     lv_obj_t *restart_label = lv_label_create(btn_restart);
     lv_label_set_text(restart_label, "Restart");
-    lv_obj_set_style_text_color(restart_label, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(restart_label, &lv_font_montserrat_16, 0);
+    lv_obj_add_style(restart_label, &ui_style_btn_label_16, 0);
     lv_obj_center(restart_label);
 }
 
@@ -131,7 +124,17 @@ static void clear_wifi_btn_event_cb(lv_event_t *e) {
     ESP.restart();
 }
 
+void destroyConfigScreen() {
+    if (!config_screen) return;
+    lv_obj_del(config_screen);
+    config_screen = nullptr;
+    qr_code = nullptr;
+    lbl_url = nullptr;
+    lbl_no_wifi = nullptr;
+}
+
 void showConfigScreen() {
+    ensureLazyScreen(LAZY_SCREEN_CONFIG);
     if (config_screen) {
         updateConfigScreenQR();
         lv_scr_load(config_screen);
@@ -144,7 +147,7 @@ void hideConfigScreen() {
 }
 
 bool isConfigScreenVisible() {
-    return lv_scr_act() == config_screen;
+    return config_screen && lv_scr_act() == config_screen;
 }
 
 void updateConfigScreenQR() {
@@ -0,0 +1,284 @@
+#include "glyph_cache.h"
+#include "ui_assets/ui_assets.h"
+#include <Arduino.h>
+#include <src/draw/sw/lv_draw_sw.h>
+
+// Every character the dashboard value labels can show ("-12.5 kW", "87 %", "3.5 hours")
+#define GLYPH_CACHE_CHARSET "0123456789.-% kWhours"
+#define GLYPH_CACHE_MAX_GLYPHS 24
+#define GLYPH_CACHE_FONT_COUNT 2
+#define GLYPH_LABEL_MAX_TEXT 32
+
+struct CachedGlyph {
+    uint32_t letter;
+    int16_t ofs_x;
+    int16_t ofs_y;
+    uint16_t box_w;
+    uint16_t box_h;
+    lv_opa_t *a8;  // box_w * box_h alpha map, nullptr for blank glyphs
+};
+
+struct GlyphCache {
+    const lv_font_t *font;
+    uint8_t count;
+    uint8_t slot[128];  // ASCII -> glyph index + 1, 0 if not cached
+    CachedGlyph glyphs[GLYPH_CACHE_MAX_GLYPHS];
+    // Advance in px (kerning included) of glyph i followed by glyph j.
+    // Column [count] is the advance with no following letter.
+    uint8_t adv[GLYPH_CACHE_MAX_GLYPHS][GLYPH_CACHE_MAX_GLYPHS + 1];
+};
+
+struct GlyphLabel {
+    const lv_font_t *font;
+    const GlyphCache *cache;  // nullptr if the font isn't cached
+    lv_color_t accent_color;
+    uint8_t len;
+    uint8_t accent_start;     // First char drawn in the accent color (== len when none)
+    lv_coord_t text_w;
+    char text[GLYPH_LABEL_MAX_TEXT];
+};
+
+static GlyphCache glyph_caches[GLYPH_CACHE_FONT_COUNT];
+static int glyph_cache_count = 0;
+
+// ============== Cache Building ==============
+
+// Expand a packed 1/2/4/8 bpp glyph bitstream (rows are not byte aligned) to A8
+static void expandGlyph(const uint8_t *src, uint8_t bpp, uint32_t px_count, lv_opa_t *dst) {
+    const uint8_t max_val = (1 << bpp) - 1;
+    uint32_t bit = 0;
+    for (uint32_t i = 0; i < px_count; i++) {
+        const uint8_t shift = 8 - bpp - (bit & 7);
+        const uint8_t val = (src[bit >> 3] >> shift) & max_val;
+        dst[i] = (lv_opa_t)((val * 255) / max_val);
+        bit += bpp;
+    }
+}
+
+static void buildGlyphCache(GlyphCache &cache, const lv_font_t *font) {
+    memset(&cache, 0, sizeof(cache));
+    cache.font = font;
+
+    size_t bytes = 0;
+    for (const char *p = GLYPH_CACHE_CHARSET; *p && cache.count < GLYPH_CACHE_MAX_GLYPHS; p++) {
+        const uint32_t letter = (uint8_t)*p;
+        if (cache.slot[letter]) continue;
+
+        lv_font_glyph_dsc_t dsc;
+        if (!lv_font_get_glyph_dsc(font, &dsc, letter, 0)) continue;
+
+        CachedGlyph &glyph = cache.glyphs[cache.count];
+        glyph.letter = letter;
+        glyph.ofs_x = dsc.ofs_x;
+        glyph.ofs_y = dsc.ofs_y;
+        glyph.box_w = dsc.box_w;
+        glyph.box_h = dsc.box_h;
+        glyph.a8 = nullptr;
+
+        const uint32_t px_count = (uint32_t)dsc.box_w * dsc.box_h;
+        if (px_count > 0) {
+            const uint8_t *src = lv_font_get_glyph_bitmap(font, letter);
+            const uint8_t bpp = dsc.bpp == 3 ? 4 : dsc.bpp;
+            if (!src || bpp > 8) continue;
+
+            // Internal RAM keeps the blend loop off the PSRAM bus
+            glyph.a8 = (lv_opa_t *)heap_caps_malloc(px_count, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+            if (!glyph.a8) continue;  // Letter falls back to the font engine
+            expandGlyph(src, bpp, px_count, glyph.a8);
+            bytes += px_count;
+        }
+
+        cache.slot[letter] = ++cache.count;
+    }
+
+    for (int i = 0; i < cache.count; i++) {
+        for (int j = 0; j < cache.count; j++) {
+            cache.adv[i][j] = lv_font_get_glyph_width(font, cache.glyphs[i].letter, cache.glyphs[j].letter);
+        }
+        cache.adv[i][cache.count] = lv_font_get_glyph_width(font, cache.glyphs[i].letter, 0);
+    }
+
+    Serial.printf("Glyph cache: %d glyphs, %u bytes (line height %d)\n",
+                  cache.count, (unsigned)bytes, font->line_height);
+}
+
+void initGlyphCache() {
+    if (glyph_cache_count > 0) return;
+    buildGlyphCache(glyph_caches[glyph_cache_count++], &space_bold_21);
+    buildGlyphCache(glyph_caches[glyph_cache_count++], &space_bold_30);
+}
+
+static const GlyphCache* findGlyphCache(const lv_font_t *font) {
+    for (int i = 0; i < glyph_cache_count; i++) {
+        if (glyph_caches[i].font == font) return &glyph_caches[i];
+    }
+    return nullptr;
+}
+
+// Cached slot index for a letter, -1 if not cached
+static inline int glyphSlot(const GlyphCache *cache, uint32_t letter) {
+    if (!cache || letter >= 128) return -1;
+    return (int)cache->slot[letter] - 1;
+}
+
+static lv_coord_t glyphAdvance(const GlyphCache *cache, const lv_font_t *font, uint32_t letter, uint32_t next) {
+    const int i = glyphSlot(cache, letter);
+    if (i >= 0) {
+        if (next == 0) return cache->adv[i][cache->count];
+        const int j = glyphSlot(cache, next);
+        if (j >= 0) return cache->adv[i][j];
+    }
+    return lv_font_get_glyph_width(font, letter, next);
+}
+
+// ============== Glyph Label Widget ==============
+
+static void drawGlyphLabel(lv_event_t *e) {
+    lv_obj_t *obj = lv_event_get_target(e);
+    GlyphLabel *label = (GlyphLabel *)lv_obj_get_user_data(obj);
+    if (!label || label->len == 0) return;
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+    label_dsc.font = label->font;
+    if (label_dsc.opa <= LV_OPA_MIN) return;
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+
+    // Clip to the object like lv_label does
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_area_t clip;
+    if (!_lv_area_intersect(&clip, &coords, draw_ctx->clip_area)) return;
+    const lv_area_t *clip_orig = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip;
+
+    const lv_font_t *font = label_dsc.font;
+    const GlyphCache *cache = label->cache;
+    const lv_color_t text_color = label_dsc.color;
+
+    lv_coord_t x = coords.x1;
+    const lv_coord_t box_w = lv_area_get_width(&coords);
+    if (label_dsc.align == LV_TEXT_ALIGN_CENTER) {
+        x += (box_w - label->text_w) / 2;
+    } else if (label_dsc.align == LV_TEXT_ALIGN_RIGHT) {
+        x += box_w - label->text_w;
+    }
+    const lv_coord_t baseline_y = coords.y1 + font->line_height - font->base_line;
+
+    // Masks (rounded parents etc.) need the full letter path
+    const bool masked = lv_draw_mask_is_any(&coords);
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.opa = label_dsc.opa;
+    blend_dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+
+    for (uint8_t i = 0; i < label->len; i++) {
+        const uint32_t letter = (uint8_t)label->text[i];
+        const uint32_t next = (uint8_t)label->text[i + 1];
+        const lv_color_t color = i >= label->accent_start ? label->accent_color : text_color;
+        const int slot = masked ? -1 : glyphSlot(cache, letter);
+
+        if (slot >= 0) {
+            const CachedGlyph &glyph = cache->glyphs[slot];
+            if (glyph.a8) {
+                lv_area_t area;
+                area.x1 = x + glyph.ofs_x;
+                area.x2 = area.x1 + glyph.box_w - 1;
+                area.y1 = baseline_y - glyph.box_h - glyph.ofs_y;
+                area.y2 = area.y1 + glyph.box_h - 1;
+
+                blend_dsc.color = color;
+                blend_dsc.blend_area = &area;
+                blend_dsc.mask_area = &area;
+                blend_dsc.mask_buf = glyph.a8;
+                lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            }
+        } else {
+            lv_point_t pos = {x, coords.y1};
+            label_dsc.color = color;
+            lv_draw_letter(draw_ctx, &label_dsc, &pos, letter);
+        }
+
+        x += glyphAdvance(cache, font, letter, next) + label_dsc.letter_space;
+    }
+
+    draw_ctx->clip_area = clip_orig;
+}
+
+static void glyphLabelEventCb(lv_event_t *e) {
+    const lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_DRAW_MAIN) {
+        drawGlyphLabel(e);
+    } else if (code == LV_EVENT_DELETE) {
+        lv_obj_t *obj = lv_event_get_target(e);
+        lv_mem_free(lv_obj_get_user_data(obj));
+        lv_obj_set_user_data(obj, nullptr);
+    }
+}
+
+lv_obj_t* createGlyphLabel(lv_obj_t *parent, const lv_font_t *font) {
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_height(obj, font->line_height);
+
+    GlyphLabel *label = (GlyphLabel *)lv_mem_alloc(sizeof(GlyphLabel));
+    LV_ASSERT_MALLOC(label);
+    if (label) {
+        lv_memset_00(label, sizeof(GlyphLabel));
+        label->font = font;
+        label->cache = findGlyphCache(font);
+        label->accent_color = lv_color_white();
+    }
+    lv_obj_set_user_data(obj, label);
+    lv_obj_add_event_cb(obj, glyphLabelEventCb, LV_EVENT_ALL, nullptr);
+
+    return obj;
+}
+
+void setGlyphLabelText(lv_obj_t *obj, const char *text, const char *accent) {
+    if (!obj) return;
+    GlyphLabel *label = (GlyphLabel *)lv_obj_get_user_data(obj);
+    if (!label) return;
+
+    char buf[GLYPH_LABEL_MAX_TEXT];
+    size_t len = strlcpy(buf, text ? text : "", sizeof(buf));
+    if (len >= sizeof(buf)) len = sizeof(buf) - 1;
+    const uint8_t accent_start = (uint8_t)len;
+    if (accent && len < sizeof(buf) - 1) {
+        len += strlcpy(buf + len, accent, sizeof(buf) - len);
+        if (len >= sizeof(buf)) len = sizeof(buf) - 1;
+    }
+
+    // Nothing to redraw if the text is unchanged
+    if (len == label->len && accent_start == label->accent_start && memcmp(buf, label->text, len) == 0) {
+        return;
+    }
+
+    memcpy(label->text, buf, len + 1);
+    label->len = (uint8_t)len;
+    label->accent_start = accent_start;
+
+    const lv_font_t *font = label->font;
+    const lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_coord_t width = 0;
+    for (uint8_t i = 0; i < label->len; i++) {
+        width += glyphAdvance(label->cache, font, (uint8_t)label->text[i], (uint8_t)label->text[i + 1]);
+        if (i + 1 < label->len) width += letter_space;
+    }
+    label->text_w = width;
+
+    lv_obj_invalidate(obj);
+}
+
+void setGlyphLabelAccentColor(lv_obj_t *obj, lv_color_t color) {
+    if (!obj) return;
+    GlyphLabel *label = (GlyphLabel *)lv_obj_get_user_data(obj);
+    if (!label) return;
+    label->accent_color = color;
+    lv_obj_invalidate(obj);
+}
@@ -2,15 +2,11 @@
 #include "main_screen.h"
 #include "config_screen.h"
 #include "mqtt_client.h"
+#include "ui_styles.h"
+#include "lazy_screens.h"
+#include "boot_timeline.h"
 #include <WiFi.h>
 
-// Theme colors (matching main screen)
-#define COLOR_BG        0x0A0C10
-#define COLOR_WHITE     0xFFFFFF
-#define COLOR_GRAY      0x6A6A6A
-#define COLOR_GREEN     0x22C55E
-#define COLOR_RED       0xEF4444
-
 // Display dimensions
 #define TFT_WIDTH 480
 #define TFT_HEIGHT 480
@@ -23,142 +19,89 @@ static lv_obj_t *lbl_ip_addr = nullptr;
 static lv_obj_t *lbl_mqtt_host = nullptr;
 static lv_obj_t *lbl_mqtt_status = nullptr;
 static lv_obj_t *lbl_last_update = nullptr;
+static lv_obj_t *lbl_boot_time = nullptr;
 
 // Forward declarations for button callbacks
 static void back_btn_event_cb(lv_event_t *e);
 static void config_btn_event_cb(lv_event_t *e);
 
+// Create one "Header:  value" row and return the value label
+static lv_obj_t* createInfoRow(const char *header_text, int x_header, int x_value, int y) {
+    lv_obj_t *header = lv_label_create(info_screen);
+    lv_label_set_text(header, header_text);
+    lv_obj_add_style(header, &ui_style_header, 0);
+    lv_obj_set_pos(header, x_header, y);
+
+    lv_obj_t *value = lv_label_create(info_screen);
+    lv_label_set_text(value, "---");
+    lv_obj_add_style(value, &ui_style_info_value, 0);
+    lv_obj_set_pos(value, x_value, y);
+    return value;
+}
+
 void createInfoScreen() {
     // Create info screen (separate from main screen)
     info_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(info_screen, lv_color_hex(COLOR_BG), 0);
+    lv_obj_add_style(info_screen, &ui_style_screen, 0);
     lv_obj_clear_flag(info_screen, LV_OBJ_FLAG_SCROLLABLE);
 
     // Title
     lv_obj_t *title = lv_label_create(info_screen);
     lv_label_set_text(title, "System Info");
-    lv_obj_set_style_text_color(title, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_24, 0);
+    lv_obj_add_style(title, &ui_style_title, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 30);
 
     // Back button
     lv_obj_t *btn_back = lv_btn_create(info_screen);
     lv_obj_set_size(btn_back, 80, 40);
     lv_obj_align(btn_back, LV_ALIGN_TOP_LEFT, 20, 20);
-    lv_obj_set_style_bg_color(btn_back, lv_color_hex(0x2A2D32), 0);
-    lv_obj_set_style_radius(btn_back, 8, 0);
+    lv_obj_add_style(btn_back, &ui_style_btn, 0);
+    lv_obj_add_style(btn_back, &ui_style_btn_dark, 0);
     lv_obj_add_event_cb(btn_back, back_btn_event_cb, LV_EVENT_CLICKED, NULL);
 
     lv_obj_t *btn_label = lv_label_create(btn_back);
     lv_label_set_text(btn_label, "< Back");
-    lv_obj_set_style_text_color(btn_label, lv_color_hex(COLOR_WHITE), 0);
+    lv_obj_add_style(btn_label, &ui_style_btn_label, 0);
     lv_obj_center(btn_label);
 
     // Config button
     lv_obj_t *btn_config = lv_btn_create(info_screen);
     lv_obj_set_size(btn_config, 80, 40);
     lv_obj_align(btn_config, LV_ALIGN_TOP_RIGHT, -20, 20);
-    lv_obj_set_style_bg_color(btn_config, lv_color_hex(0x2A2D32), 0);
-    lv_obj_set_style_radius(btn_config, 8, 0);
+    lv_obj_add_style(btn_config, &ui_style_btn, 0);
+    lv_obj_add_style(btn_config, &ui_style_btn_dark, 0);
     lv_obj_add_event_cb(btn_config, config_btn_event_cb, LV_EVENT_CLICKED, NULL);
 
     lv_obj_t *config_label = lv_label_create(btn_config);
     lv_label_set_text(config_label, "Config >");
-    lv_obj_set_style_text_color(config_label, lv_color_hex(COLOR_WHITE), 0);
+    lv_obj_add_style(config_label, &ui_style_btn_label, 0);
     lv_obj_center(config_label);
 
-    // Info container
+    // Info rows
     int y_offset = 100;
     int label_spacing = 50;
     int left_margin = 40;
+    int value_x = 200;
 
-    // WiFi Status
-    lv_obj_t *wifi_header = lv_label_create(info_screen);
-    lv_label_set_text(wifi_header, "WiFi Status:");
-    lv_obj_set_style_text_color(wifi_header, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(wifi_header, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(wifi_header, left_margin, y_offset);
-
-    lbl_wifi_status = lv_label_create(info_screen);
-    lv_label_set_text(lbl_wifi_status, "---");
-    lv_obj_set_style_text_color(lbl_wifi_status, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_wifi_status, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(lbl_wifi_status, 200, y_offset);
-
+    lbl_wifi_status = createInfoRow("WiFi Status:", left_margin, value_x, y_offset);
     y_offset += label_spacing;
-
-    // WiFi SSID
-    lv_obj_t *ssid_header = lv_label_create(info_screen);
-    lv_label_set_text(ssid_header, "Network:");
-    lv_obj_set_style_text_color(ssid_header, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(ssid_header, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(ssid_header, left_margin, y_offset);
-
-    lbl_wifi_ssid = lv_label_create(info_screen);
-    lv_label_set_text(lbl_wifi_ssid, "---");
-    lv_obj_set_style_text_color(lbl_wifi_ssid, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_wifi_ssid, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(lbl_wifi_ssid, 200, y_offset);
-
+    lbl_wifi_ssid = createInfoRow("Network:", left_margin, value_x, y_offset);
     y_offset += label_spacing;
-
-    // IP Address
-    lv_obj_t *ip_header = lv_label_create(info_screen);
-    lv_label_set_text(ip_header, "IP Address:");
-    lv_obj_set_style_text_color(ip_header, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(ip_header, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(ip_header, left_margin, y_offset);
-
-    lbl_ip_addr = lv_label_create(info_screen);
-    lv_label_set_text(lbl_ip_addr, "---");
-    lv_obj_set_style_text_color(lbl_ip_addr, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_ip_addr, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(lbl_ip_addr, 200, y_offset);
-
+    lbl_ip_addr = createInfoRow("IP Address:", left_margin, value_x, y_offset);
     y_offset += label_spacing;
-
-    // MQTT Broker
-    lv_obj_t *mqtt_header = lv_label_create(info_screen);
-    lv_label_set_text(mqtt_header, "MQTT Broker:");
-    lv_obj_set_style_text_color(mqtt_header, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(mqtt_header, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(mqtt_header, left_margin, y_offset);
-
-    lbl_mqtt_host = lv_label_create(info_screen);
-    lv_label_set_text(lbl_mqtt_host, "---");
-    lv_obj_set_style_text_color(lbl_mqtt_host, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_mqtt_host, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(lbl_mqtt_host, 200, y_offset);
-
+    lbl_mqtt_host = createInfoRow("MQTT Broker:", left_margin, value_x, y_offset);
     y_offset += label_spacing;
-
-    // MQTT Status
-    lv_obj_t *mqtt_status_header = lv_label_create(info_screen);
-    lv_label_set_text(mqtt_status_header, "MQTT Status:");
-    lv_obj_set_style_text_color(mqtt_status_header, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(mqtt_status_header, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(mqtt_status_header, left_margin, y_offset);
-
-    lbl_mqtt_status = lv_label_create(info_screen);
-    lv_label_set_text(lbl_mqtt_status, "---");
-    lv_obj_set_style_text_color(lbl_mqtt_status, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_mqtt_status, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(lbl_mqtt_status, 200, y_offset);
-
+    lbl_mqtt_status = createInfoRow("MQTT Status:", left_margin, value_x, y_offset);
     y_offset += label_spacing;
+    lbl_last_update = createInfoRow("Last Update:", left_margin, value_x, y_offset);
+    y_offset += label_spacing;
+    lbl_boot_time = createInfoRow("Boot Time:", left_margin, value_x, y_offset);
 
-    // Last Update
-    lv_obj_t *update_header = lv_label_create(info_screen);
-    lv_label_set_text(update_header, "Last Update:");
-    lv_obj_set_style_text_color(update_header, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(update_header, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(update_header, left_margin, y_offset);
-
-    lbl_last_update = lv_label_create(info_screen);
-    lv_label_set_text(lbl_last_update, "---");
-    lv_obj_set_style_text_color(lbl_last_update, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_last_update, &lv_font_montserrat_16, 0);
-    lv_obj_set_pos(lbl_last_update, 200, y_offset);
+    // Status labels switch between error (default) and OK colors by state
+    lv_obj_add_style(lbl_wifi_status, &ui_style_status_error, 0);
+    lv_obj_add_style(lbl_wifi_status, &ui_style_status_ok, UI_STATE_OK);
+    lv_obj_add_style(lbl_mqtt_status, &ui_style_status_error, 0);
+    lv_obj_add_style(lbl_mqtt_status, &ui_style_status_ok, UI_STATE_OK);
 }
 
 static void back_btn_event_cb(lv_event_t *e) {
@@ -169,7 +112,21 @@ static void config_btn_event_cb(lv_event_t *e) {
     showConfigScreen();
 }
 
+void destroyInfoScreen() {
+    if (!info_screen) return;
+    lv_obj_del(info_screen);
+    info_screen = nullptr;
+    lbl_wifi_status = nullptr;
+    lbl_wifi_ssid = nullptr;
+    lbl_ip_addr = nullptr;
+    lbl_mqtt_host = nullptr;
+    lbl_mqtt_status = nullptr;
+    lbl_last_update = nullptr;
+    lbl_boot_time = nullptr;
+}
+
 void showInfoScreen() {
+    ensureLazyScreen(LAZY_SCREEN_INFO);
     if (info_screen) {
         updateInfoScreenData();
         lv_scr_load(info_screen);
@@ -184,7 +141,7 @@ void hideInfoScreen() {
 }
 
 bool isInfoScreenVisible() {
-    return lv_scr_act() == info_screen;
+    return info_screen && lv_scr_act() == info_screen;
 }
 
 void updateInfoScreenData() {
@@ -193,7 +150,7 @@ void updateInfoScreenData() {
     // WiFi Status
     if (WiFi.status() == WL_CONNECTED) {
         lv_label_set_text(lbl_wifi_status, "Connected");
-        lv_obj_set_style_text_color(lbl_wifi_status, lv_color_hex(COLOR_GREEN), 0);
+        lv_obj_add_state(lbl_wifi_status, UI_STATE_OK);
 
         // SSID
         lv_label_set_text(lbl_wifi_ssid, WiFi.SSID().c_str());
@@ -202,14 +159,20 @@ void updateInfoScreenData() {
         lv_label_set_text(lbl_ip_addr, WiFi.localIP().toString().c_str());
     } else {
         lv_label_set_text(lbl_wifi_status, "Disconnected");
-        lv_obj_set_style_text_color(lbl_wifi_status, lv_color_hex(COLOR_RED), 0);
+        lv_obj_clear_state(lbl_wifi_status, UI_STATE_OK);
         lv_label_set_text(lbl_wifi_ssid, "---");
         lv_label_set_text(lbl_ip_addr, "---");
     }
 
-    // MQTT Broker host:port
+    // MQTT Broker host:port (the endpoint in use when connected to a fallback)
     MQTTConfig& config = mqttClient.getConfig();
-    if (config.host.length() > 0) {
+    const int active = mqttClient.getActiveEndpoint();
+    if (active >= 0) {
+        const MQTTEndpoint& endpoint = mqttClient.getEndpoint(active);
+        char mqtt_addr[64];
+        snprintf(mqtt_addr, sizeof(mqtt_addr), "%s:%d", endpoint.host.c_str(), endpoint.port);
+        lv_label_set_text(lbl_mqtt_host, mqtt_addr);
+    } else if (config.host.length() > 0) {
         char mqtt_addr[64];
         snprintf(mqtt_addr, sizeof(mqtt_addr), "%s:%d", config.host.c_str(), config.port);
         lv_label_set_text(lbl_mqtt_host, mqtt_addr);
@@ -220,10 +183,10 @@ void updateInfoScreenData() {
     // MQTT Status
     if (mqttClient.isConnected()) {
         lv_label_set_text(lbl_mqtt_status, "Connected");
-        lv_obj_set_style_text_color(lbl_mqtt_status, lv_color_hex(COLOR_GREEN), 0);
+        lv_obj_add_state(lbl_mqtt_status, UI_STATE_OK);
     } else {
         lv_label_set_text(lbl_mqtt_status, "Disconnected");
-        lv_obj_set_style_text_color(lbl_mqtt_status, lv_color_hex(COLOR_RED), 0);
+        lv_obj_clear_state(lbl_mqtt_status, UI_STATE_OK);
     }
 
     // Last update time
@@ -241,4 +204,17 @@ void updateInfoScreenData() {
     } else {
         lv_label_set_text(lbl_last_update, "No data yet");
     }
+
+    // Boot timeline: first frame and fully ready (network + NTP)
+    char boot_str[48];
+    if (getBootReadyMs() > 0) {
+        snprintf(boot_str, sizeof(boot_str), "frame %lu ms, ready %lu.%lu s",
+                 (unsigned long)getBootFirstFrameMs(),
+                 (unsigned long)(getBootReadyMs() / 1000),
+                 (unsigned long)(getBootReadyMs() % 1000 / 100));
+    } else {
+        snprintf(boot_str, sizeof(boot_str), "frame %lu ms, starting...",
+                 (unsigned long)getBootFirstFrameMs());
+    }
+    lv_label_set_text(lbl_boot_time, boot_str);
 }
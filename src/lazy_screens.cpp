@@ -0,0 +1,100 @@
+#include "lazy_screens.h"
+#include "lvgl_heap.h"
+
+// How often the idle check runs
+#define LAZY_SCREEN_CHECK_INTERVAL 1000
+
+struct LazyScreen {
+    LazyScreenCreateFn create;
+    LazyScreenDestroyFn destroy;
+    LazyScreenVisibleFn is_visible;
+    unsigned long idle_timeout_ms;
+    unsigned long hidden_since;  // 0 while visible or not yet observed hidden
+    LazyScreenStats stats;
+};
+
+static LazyScreen lazy_screens[LAZY_SCREEN_COUNT];
+static unsigned long last_lazy_check = 0;
+
+static uint32_t lvglHeapUsed() {
+    lvgl_heap_stats_t stats;
+    lvgl_heap_get_stats(&stats);
+    return stats.used_bytes;
+}
+
+void registerLazyScreen(LazyScreenId id, const char *name,
+                        LazyScreenCreateFn create, LazyScreenDestroyFn destroy,
+                        LazyScreenVisibleFn is_visible, unsigned long idle_timeout_ms) {
+    if (id >= LAZY_SCREEN_COUNT) return;
+
+    LazyScreen &screen = lazy_screens[id];
+    screen.create = create;
+    screen.destroy = destroy;
+    screen.is_visible = is_visible;
+    screen.idle_timeout_ms = idle_timeout_ms;
+    screen.hidden_since = 0;
+    screen.stats.name = name;
+}
+
+bool ensureLazyScreen(LazyScreenId id) {
+    if (id >= LAZY_SCREEN_COUNT) return false;
+
+    LazyScreen &screen = lazy_screens[id];
+    if (screen.stats.resident) return true;
+    if (!screen.create) return false;
+
+    const uint32_t mem_before = lvglHeapUsed();
+    const unsigned long start_us = micros();
+
+    screen.create();
+
+    screen.stats.last_create_us = micros() - start_us;
+    screen.stats.last_mem_bytes = (int32_t)lvglHeapUsed() - (int32_t)mem_before;
+    screen.stats.create_count++;
+    screen.stats.resident = true;
+    screen.hidden_since = 0;
+
+    Serial.printf("Screen '%s' created in %lu us, %ld bytes LVGL heap\n",
+                  screen.stats.name, (unsigned long)screen.stats.last_create_us,
+                  (long)screen.stats.last_mem_bytes);
+    return true;
+}
+
+void updateLazyScreens() {
+    const unsigned long now = millis();
+    if (now - last_lazy_check < LAZY_SCREEN_CHECK_INTERVAL) return;
+    last_lazy_check = now;
+
+    for (int i = 0; i < LAZY_SCREEN_COUNT; i++) {
+        LazyScreen &screen = lazy_screens[i];
+        if (!screen.stats.resident || screen.idle_timeout_ms == LAZY_SCREEN_KEEP || !screen.destroy) {
+            continue;
+        }
+
+        if (screen.is_visible && screen.is_visible()) {
+            screen.hidden_since = 0;
+            continue;
+        }
+
+        if (screen.hidden_since == 0) {
+            screen.hidden_since = now;
+            continue;
+        }
+
+        if (now - screen.hidden_since >= screen.idle_timeout_ms) {
+            const uint32_t mem_before = lvglHeapUsed();
+            screen.destroy();
+            screen.stats.resident = false;
+            screen.hidden_since = 0;
+            Serial.printf("Screen '%s' destroyed after %lu ms off-screen, freed %ld bytes\n",
+                          screen.stats.name, screen.idle_timeout_ms,
+                          (long)mem_before - (long)lvglHeapUsed());
+        }
+    }
+}
+
+const LazyScreenStats& getLazyScreenStats(LazyScreenId id) {
+    static const LazyScreenStats empty = {"", false, 0, 0, 0};
+    if (id >= LAZY_SCREEN_COUNT) return empty;
+    return lazy_screens[id].stats;
+}
@@ -0,0 +1,178 @@
+#include "lvgl_heap.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <multi_heap.h>
+#include <string.h>
+
+// LVGL heap built on ESP-IDF's multi_heap (the same allocator the system heap
+// uses) so it gets the same block splitting/coalescing and stats for free.
+
+// Minimum time between "pool exhausted" log lines
+#define LVGL_HEAP_LOG_INTERVAL 5000
+
+struct LvglPool {
+    uint8_t *base;
+    size_t size;
+    multi_heap_handle_t heap;
+    portMUX_TYPE lock;
+};
+
+static LvglPool psram_pool = {nullptr, 0, nullptr, portMUX_INITIALIZER_UNLOCKED};
+static LvglPool fast_pool = {nullptr, 0, nullptr, portMUX_INITIALIZER_UNLOCKED};
+static bool heap_initialized = false;
+
+static uint32_t alloc_count = 0;
+static uint32_t fast_alloc_count = 0;
+static uint32_t overflow_count = 0;
+static uint32_t failure_count = 0;
+static unsigned long last_exhausted_log = 0;
+
+static void initPool(LvglPool &pool, size_t size, uint32_t caps, const char *name) {
+    pool.base = (uint8_t *)heap_caps_malloc(size, caps);
+    if (!pool.base) {
+        Serial.printf("LVGL heap: failed to reserve %u byte %s pool\n", (unsigned)size, name);
+        return;
+    }
+    pool.heap = multi_heap_register(pool.base, size);
+    if (!pool.heap) {
+        heap_caps_free(pool.base);
+        pool.base = nullptr;
+        Serial.printf("LVGL heap: failed to register %s pool\n", name);
+        return;
+    }
+    pool.size = size;
+    multi_heap_set_lock(pool.heap, &pool.lock);
+    Serial.printf("LVGL heap: %u byte %s pool at %p\n", (unsigned)size, name, pool.base);
+}
+
+// Pools are created on the first allocation, which happens inside lv_init()
+static void ensureInitialized() {
+    if (heap_initialized) return;
+    heap_initialized = true;
+    initPool(psram_pool, LVGL_HEAP_PSRAM_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, "PSRAM");
+    initPool(fast_pool, LVGL_HEAP_FAST_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, "internal");
+}
+
+static bool poolOwns(const LvglPool &pool, const void *ptr) {
+    return pool.heap && (const uint8_t *)ptr >= pool.base && (const uint8_t *)ptr < pool.base + pool.size;
+}
+
+static void logExhausted(size_t size) {
+    const unsigned long now = millis();
+    if (last_exhausted_log != 0 && now - last_exhausted_log < LVGL_HEAP_LOG_INTERVAL) return;
+    last_exhausted_log = now;
+    Serial.printf("LVGL heap: pool exhausted for %u bytes (overflows: %lu, failures: %lu)\n",
+                  (unsigned)size, (unsigned long)overflow_count, (unsigned long)failure_count);
+}
+
+// Last resort when both pools are full: the general PSRAM heap
+static void *overflowAlloc(size_t size) {
+    void *ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ptr) {
+        overflow_count++;
+    } else {
+        failure_count++;
+    }
+    logExhausted(size);
+    return ptr;
+}
+
+extern "C" void *lvgl_heap_alloc(size_t size) {
+    if (size == 0) return nullptr;
+    ensureInitialized();
+    alloc_count++;
+
+    if (size <= LVGL_HEAP_FAST_MAX && fast_pool.heap) {
+        void *ptr = multi_heap_malloc(fast_pool.heap, size);
+        if (ptr) {
+            fast_alloc_count++;
+            return ptr;
+        }
+    }
+
+    if (psram_pool.heap) {
+        void *ptr = multi_heap_malloc(psram_pool.heap, size);
+        if (ptr) return ptr;
+    }
+
+    return overflowAlloc(size);
+}
+
+extern "C" void lvgl_heap_free(void *ptr) {
+    if (!ptr) return;
+
+    if (poolOwns(fast_pool, ptr)) {
+        multi_heap_free(fast_pool.heap, ptr);
+    } else if (poolOwns(psram_pool, ptr)) {
+        multi_heap_free(psram_pool.heap, ptr);
+    } else {
+        heap_caps_free(ptr);
+    }
+}
+
+extern "C" void *lvgl_heap_realloc(void *ptr, size_t new_size) {
+    if (!ptr) return lvgl_heap_alloc(new_size);
+    if (new_size == 0) {
+        lvgl_heap_free(ptr);
+        return nullptr;
+    }
+
+    LvglPool *owner = nullptr;
+    if (poolOwns(fast_pool, ptr)) {
+        owner = &fast_pool;
+    } else if (poolOwns(psram_pool, ptr)) {
+        owner = &psram_pool;
+    } else {
+        // Overflow block from the system heap
+        void *moved = heap_caps_realloc(ptr, new_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!moved) failure_count++;
+        return moved;
+    }
+
+    // Grow/shrink in place when the block stays in the right pool
+    if (owner == &psram_pool || new_size <= LVGL_HEAP_FAST_MAX) {
+        void *resized = multi_heap_realloc(owner->heap, ptr, new_size);
+        if (resized) return resized;
+    }
+
+    // Move to another pool
+    const size_t old_size = multi_heap_get_allocated_size(owner->heap, ptr);
+    void *moved = lvgl_heap_alloc(new_size);
+    if (!moved) return nullptr;
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    multi_heap_free(owner->heap, ptr);
+    return moved;
+}
+
+extern "C" void lvgl_heap_get_stats(lvgl_heap_stats_t *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    ensureInitialized();
+
+    multi_heap_info_t info;
+    if (psram_pool.heap) {
+        multi_heap_get_info(psram_pool.heap, &info);
+        stats->total_bytes += psram_pool.size;
+        stats->used_bytes += info.total_allocated_bytes;
+        stats->free_bytes += info.total_free_bytes;
+        stats->largest_free_block = info.largest_free_block;
+        stats->min_free_bytes = info.minimum_free_bytes;
+        if (info.total_free_bytes > 0) {
+            stats->frag_pct = 100 - (uint8_t)((uint64_t)info.largest_free_block * 100 / info.total_free_bytes);
+        }
+    }
+
+    if (fast_pool.heap) {
+        multi_heap_get_info(fast_pool.heap, &info);
+        stats->total_bytes += fast_pool.size;
+        stats->used_bytes += info.total_allocated_bytes;
+        stats->free_bytes += info.total_free_bytes;
+        stats->fast_used_bytes = info.total_allocated_bytes;
+        stats->fast_free_bytes = info.total_free_bytes;
+    }
+
+    stats->alloc_count = alloc_count;
+    stats->fast_alloc_count = fast_alloc_count;
+    stats->overflow_count = overflow_count;
+    stats->failure_count = failure_count;
+}
@@ -7,19 +7,23 @@
 #include "ui_assets/ui_assets.h"
 #include "mqtt_client.h"
 #include "web_server.h"
-#include "boot_screen.h"
 #include "main_screen.h"
 #include "info_screen.h"
-#include "config_screen.h"
 #include "wifi_error_screen.h"
-#include "mqtt_config_screen.h"
 #include "improv_wifi.h"
+#include "wifi_manager.h"
 #include "display_config.h"
 #include "captive_portal.h"
 #include "brightness_config.h"
 #include "brightness_controller.h"
 #include "time_config.h"
 #include "screenshot.h"
+#include "lazy_screens.h"
+#include "ui_screens.h"
+#include "boot_timeline.h"
+#include "metrics_store.h"
+#include "wall_clock.h"
+#include "network_recovery.h"
 
 // Touch controller pins for Guition ESP32-S3-4848S040
 #define TOUCH_SDA 19
@@ -55,6 +59,17 @@ Arduino_ST7701_RGBPanel *gfx = new Arduino_ST7701_RGBPanel(
 #define TFT_WIDTH 480
 #define TFT_HEIGHT 480
 
+// ST7701 sleep commands and their settle times (datasheet)
+#define ST7701_SLPIN 0x10
+#define ST7701_SLPOUT 0x11
+#define ST7701_DISPOFF 0x28
+#define ST7701_DISPON 0x29
+#define ST7701_SLPIN_DELAY_MS 5
+#define ST7701_SLPOUT_DELAY_MS 120  // Also the minimum time between sleep in and sleep out
+
+// loop() pacing while the display sleeps (touch is polled every LVGL indev period)
+#define DISPLAY_SLEEP_LOOP_DELAY_MS 20
+
 // LVGL display buffers (double buffered)
 static lv_disp_draw_buf_t draw_buf;
 static lv_color_t *disp_draw_buf1;
@@ -71,15 +86,34 @@ static lv_indev_t *touch_indev = nullptr;
 // Current display rotation (loaded from config)
 static DisplayRotation current_rotation = ROTATION_0;
 
+// Set by a touch that woke the display, until the finger lifts
+static bool swallow_touch = false;
+
+// Boot work deferred until after the first frame
+enum DeferredBootStage : uint8_t {
+    BOOT_STAGE_NETWORK = 0,
+    BOOT_STAGE_SCREENSHOT,
+    BOOT_STAGE_TIME,
+    BOOT_STAGE_NTP,
+    BOOT_STAGE_DONE
+};
+static DeferredBootStage deferred_boot_stage = BOOT_STAGE_NETWORK;
+static bool first_time_sync_done = false;  // First NTP result, success or timeout
+
 // Touch read callback for LVGL
 void my_touchpad_read(lv_indev_drv_t *drv, lv_indev_data_t *data) {
     touchController.read();
 
     if (touchController.isTouched) {
-        data->state = LV_INDEV_STATE_PRESSED;
+        // Notify brightness controller of touch activity. A touch that wakes
+        // the display is swallowed so it can't press whatever is under it.
+        if (brightnessController.onTouchDetected() || swallow_touch) {
+            swallow_touch = true;
+            data->state = LV_INDEV_STATE_RELEASED;
+            return;
+        }
 
-        // Notify brightness controller of touch activity
-        brightnessController.onTouchDetected();
+        data->state = LV_INDEV_STATE_PRESSED;
 
         // Raw touch coordinates from GT911
         int16_t raw_x = touchController.points[0].x;
@@ -99,6 +133,7 @@ void my_touchpad_read(lv_indev_drv_t *drv, lv_indev_data_t *data) {
         }
 
     } else {
+        swallow_touch = false;
         data->state = LV_INDEV_STATE_RELEASED;
     }
 }
@@ -123,99 +158,188 @@ void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color
     lv_disp_flush_ready(disp);
 }
 
+// Display sleep (backlight is handled by the brightness controller)
+static void onDisplaySleep(bool asleep) {
+    static unsigned long sleep_in_ms = 0;
+    lv_disp_t *disp = lv_disp_get_default();
+
+    if (asleep) {
+        // Stop rendering, then put the panel to sleep before its pixel clock stops
+        lv_timer_pause(disp->refr_timer);
+        bus->sendCommand(ST7701_DISPOFF);
+        bus->sendCommand(ST7701_SLPIN);
+        delay(ST7701_SLPIN_DELAY_MS);
+        bus->stopScanout();
+        sleep_in_ms = millis();
+        return;
+    }
+
+    const unsigned long asleep_ms = millis() - sleep_in_ms;
+    if (asleep_ms < ST7701_SLPOUT_DELAY_MS) {
+        delay(ST7701_SLPOUT_DELAY_MS - asleep_ms);
+    }
+    bus->startScanout();
+    bus->sendCommand(ST7701_SLPOUT);
+    const unsigned long sleep_out_ms = millis();
+
+    // Render the current state while the panel wakes so the first visible frame is fresh
+    lv_obj_invalidate(lv_scr_act());
+    lv_timer_resume(disp->refr_timer);
+    lv_refr_now(disp);
+
+    const unsigned long elapsed_ms = millis() - sleep_out_ms;
+    if (elapsed_ms < ST7701_SLPOUT_DELAY_MS) {
+        delay(ST7701_SLPOUT_DELAY_MS - elapsed_ms);
+    }
+    bus->sendCommand(ST7701_DISPON);
+}
+
+// First NTP result (and later successes after a failure)
+static void onTimeSync(bool success) {
+    first_time_sync_done = true;
+    if (success) {
+        // Clock listeners (day/night brightness) follow now, not on the next second
+        updateWallClock();
+    }
+}
+
+// Going off-grid wakes the display (if configured)
+static void onOffGridStatus(int offgrid) {
+    static int last_offgrid = 0;
+    if (offgrid && !last_offgrid && brightnessConfig.getConfig().wakeOnOffGrid) {
+        brightnessController.requestWake();
+    }
+    last_offgrid = offgrid;
+}
+
 void setup() {
     Serial.begin(115200);
-    delay(100);
     Serial.println("\n\nPowerwall Display Starting...");
 
-    // Load display configuration (rotation setting)
+    // Configuration (NVS reads only)
     displayConfig.begin();
     current_rotation = displayConfig.getConfig().rotation;
     Serial.printf("Display rotation: %d degrees\n",
                   DisplayConfigManager::rotationToDegrees(current_rotation));
-
-    // Load brightness configuration
     brightnessConfig.begin();
-    Serial.println("Brightness configuration loaded");
+    timeConfig.begin();
+    timeConfig.setSyncCallback(onTimeSync);
+
+    // Setup MQTT callbacks (each value is also kept for the next boot)
+    mqttClient.setSolarCallback([](float w) { recordMetric(METRIC_SOLAR, w); updateSolarValue(w); });
+    mqttClient.setGridCallback([](float w) { recordMetric(METRIC_GRID, w); updateGridValue(w); });
+    mqttClient.setHomeCallback([](float w) { recordMetric(METRIC_HOME, w); updateHomeValue(w); });
+    mqttClient.setBatteryCallback([](float w) { recordMetric(METRIC_BATTERY, w); updateBatteryValue(w); });
+    mqttClient.setSOCCallback([](float soc) { recordMetric(METRIC_SOC, soc); updateSOC(soc); });
+    mqttClient.setOffGridCallback([](int offgrid) {
+        recordMetric(METRIC_OFFGRID, offgrid);
+        updateOffGridStatus(offgrid);
+        onOffGridStatus(offgrid);
+    });
+    mqttClient.setTimeRemainingCallback([](float h) { recordMetric(METRIC_TIME_REMAINING, h); updateTimeRemaining(h); });
+
+    // Setup EV callbacks
+    mqttClient.setEVCallback([](float w) { recordMetric(METRIC_EV, w); updateEVValue(w); });
+    mqttClient.setEVConnectedCallback([](bool c) { recordMetric(METRIC_EV_CONNECTED, c ? 1.0f : 0.0f); updateEVConnected(c); });
+    mqttClient.setEVSOCCallback([](float soc) { recordMetric(METRIC_EV_SOC, soc); updateEVSOC(soc); });
+    mqttClient.setExtraNodeCallback(updateExtraNodeValue);
 
-    // Initialize screenshot storage
-    initScreenshot();
+    // Load MQTT config (connects later, once WiFi is up)
+    mqttClient.begin();
+    markBootStage("config");
 
-    // Setup display hardware first
     setupDisplay();
-    
-    // Initialize brightness controller (after display setup)
-    brightnessController.begin();
+    markBootStage("display");
 
-    // Initialize LVGL
     setupLVGL();
-
-    // Initialize touch
     setupTouch();
+    markBootStage("lvgl");
 
-    // Create UI
     createUI();
+    setEVEnabled(mqttClient.getConfig().ev_enabled);
 
-    // Show boot screen initially
-    showBootScreen();
-    boot_start_time = millis();
-    lv_timer_handler();
+    // Extra flow nodes (generator, batteries, chargers) from the MQTT config
+    PowerNodeRole extra_roles[MQTT_MAX_EXTRA_NODES];
+    for (uint8_t i = 0; i < mqttClient.getExtraNodeCount(); i++) extra_roles[i] = mqttClient.getExtraNode(i).role;
+    configureExtraNodes(extra_roles, mqttClient.getExtraNodeCount());
+
+    // Show the last known values until MQTT delivers fresh ones
+    StoredMetrics last_metrics;
+    if (loadStoredMetrics(last_metrics)) {
+        applyRestoredMetrics(last_metrics);
+    }
+    markBootStage("ui");
+
+    // Render the dashboard now, then turn on the backlight so the first
+    // thing visible is a complete frame
+    lv_refr_now(NULL);
+    markBootFirstFrame();
+    brightnessController.setSleepCallback(onDisplaySleep);
+    brightnessController.begin();
+    markBootStage("backlight");
 
     // Check PSRAM
     if (psramFound()) {
         Serial.printf("PSRAM found: %d bytes\n", ESP.getPsramSize());
     }
 
-    // Setup Improv WiFi
-    setupImprovWiFi();
-
-    // Try to connect with saved credentials
-    String saved_ssid = "";
-    String saved_pass = "";
+    // Networking, NTP and the screenshot buffer follow from loop()
+    // Note: Web server is started after WiFi connects (in checkWiFiConnection)
+    // to avoid port conflict with captive portal
+}
 
-    if (wifi_preferences.begin("wifi", false)) {
-        if (wifi_preferences.isKey("ssid")) {
-            saved_ssid = wifi_preferences.getString("ssid", "");
-            saved_pass = wifi_preferences.getString("password", "");
-        }
-        wifi_preferences.end();
-    }
+// Start WiFi with saved credentials, or the captive portal without them
+static void startNetworking() {
+    setupWiFi();
+    setupImprovWiFi();
 
-    if (saved_ssid.length() > 0) {
+    String saved_ssid;
+    String saved_pass;
+    if (loadWiFiCredentials(saved_ssid, saved_pass)) {
         connectToWiFi(saved_ssid.c_str(), saved_pass.c_str());
-        // Initialize time configuration and sync with NTP (after WiFi)
-        // This will be called again in checkWiFiConnection once WiFi is connected
-        timeConfig.begin();
     } else {
         // No saved credentials - start captive portal for WiFi setup
-        hideBootScreen();
         showWifiErrorScreen("WiFi not configured\nConnect to 'Powerwall-Display'\nto set up");
-        lv_timer_handler();  // Render the screen change immediately
         startCaptivePortal();
     }
+}
 
-    // Setup MQTT callbacks
-    mqttClient.setSolarCallback(updateSolarValue);
-    mqttClient.setGridCallback(updateGridValue);
-    mqttClient.setHomeCallback(updateHomeValue);
-    mqttClient.setBatteryCallback(updateBatteryValue);
-    mqttClient.setSOCCallback(updateSOC);
-    mqttClient.setOffGridCallback(updateOffGridStatus);
-    mqttClient.setTimeRemainingCallback(updateTimeRemaining);
-
-    // Setup EV callbacks
-    mqttClient.setEVCallback(updateEVValue);
-    mqttClient.setEVConnectedCallback(updateEVConnected);
-    mqttClient.setEVSOCCallback(updateEVSOC);
-
-    // Initialize MQTT client (will load config from flash)
-    mqttClient.begin();
-
-    // Initialize EV display state from config
-    setEVEnabled(mqttClient.getConfig().ev_enabled);
-
-    // Note: Web server is started after WiFi connects (in checkWiFiConnection)
-    // to avoid port conflict with captive portal
+// Runs one deferred boot stage per loop() pass so the UI keeps rendering
+static void runDeferredBootStage() {
+    switch (deferred_boot_stage) {
+        case BOOT_STAGE_NETWORK:
+            startNetworking();
+            markBootStage("network");
+            deferred_boot_stage = BOOT_STAGE_SCREENSHOT;
+            break;
+
+        case BOOT_STAGE_SCREENSHOT:
+            initScreenshot();
+            markBootStage("screenshot");
+            deferred_boot_stage = BOOT_STAGE_TIME;
+            break;
+
+        case BOOT_STAGE_TIME:
+            // NTP needs the network (also covers provisioning via Improv/portal)
+            if (getWiFiStats().state != WIFI_STATE_CONNECTED) return;
+            markBootStage("wifi");
+            timeConfig.syncTime();
+            deferred_boot_stage = BOOT_STAGE_NTP;
+            break;
+
+        case BOOT_STAGE_NTP:
+            // Boot is complete once the first sync finished, failed or isn't enabled
+            if (timeConfig.getConfig().ntpEnabled && !first_time_sync_done) {
+                return;
+            }
+            markBootStage("ntp");
+            markBootComplete();
+            deferred_boot_stage = BOOT_STAGE_DONE;
+            break;
+
+        case BOOT_STAGE_DONE:
+            break;
+    }
 }
 
 void loop() {
@@ -225,15 +349,24 @@ void loop() {
     last_tick = now;
 
     lv_timer_handler();
+    runDeferredBootStage();
     loopCaptivePortal();
     loopImprov();
     checkWiFiConnection();
     mqttClient.loop();  // Handle MQTT auto-reconnect
-    updateDataRxPulse();
-    updatePowerFlowAnimation();
+    loopNetworkRecovery();  // Escalate long outages (driver reset, MQTT reinit, reboot)
+    timeConfig.loop();  // NTP sync progress
+    if (!brightnessController.isAsleep()) {
+        updateDataRxPulse();
+        updatePowerFlowAnimation();
+    }
+    loopMetricsStore();
+    webServer.loop();  // Stats snapshot for /api/stats
     
-    // Update brightness controller for time-based and idle dimming
+    // Refresh cached local time (once per second), then time-based and idle dimming
+    updateWallClock();
     brightnessController.update();
+    setDashboardDimmed(brightnessController.isDimmed());  // Animations slow down while dimmed
 
     // Update info screen data if visible
     if (isInfoScreenVisible()) {
@@ -245,11 +378,12 @@ void loop() {
         updateWifiErrorCountdown(getNextWiFiRetryTime());
     }
 
-    // Check boot screen timeout
-    if (isBootScreenVisible()) {
-        if (millis() - boot_start_time > BOOT_SCREEN_TIMEOUT) {
-            hideBootScreen();
-        }
+    // Free secondary screens that have been off-screen for a while
+    updateLazyScreens();
+
+    // Nothing renders while asleep; touch, MQTT and the web server keep running
+    if (brightnessController.isAsleep()) {
+        delay(DISPLAY_SLEEP_LOOP_DELAY_MS);
     }
 }
 
@@ -260,9 +394,8 @@ void setupDisplay() {
     // Apply display rotation from config
     gfx->setRotation(static_cast<uint8_t>(current_rotation));
 
-    gfx->fillScreen(BLACK);
-    // Note: Backlight PWM is now handled by brightness controller
-    // Don't set it here to avoid conflicts
+    // No fillScreen: the backlight stays off until LVGL has drawn the first frame.
+    // Backlight PWM is handled by the brightness controller.
 }
 
 void setupLVGL() {
@@ -315,10 +448,10 @@ void setupTouch() {
 }
 
 void createUI() {
-    createMainDashboard();
-    createInfoScreen();
-    createConfigScreen();
-    createMqttConfigScreen(getMainScreen());
-    createWifiErrorScreen(getMainScreen());
-    createBootScreen(getMainScreen());
+    const uint32_t mem_before = logLvglMemory("before UI");
+
+    createScreens();
+
+    const uint32_t mem_after = logLvglMemory("after UI");
+    Serial.printf("UI objects use %u bytes of LVGL heap\n", (unsigned)(mem_after - mem_before));
 }
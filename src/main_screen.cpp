@@ -1,8 +1,13 @@
 #include "main_screen.h"
 #include "info_screen.h"
 #include "mqtt_config_screen.h"
+#include "wifi_error_screen.h"
+#include "glyph_cache.h"
+#include "view_model.h"
+#include "ui_styles.h"
 #include "ui_assets/ui_assets.h"
 #include "mqtt_client.h"
+#include "power_flow.h"
 #include <WiFi.h>
 #include <cmath>
 
@@ -10,87 +15,74 @@
 #define TFT_WIDTH 480
 #define TFT_HEIGHT 480
 
-// UI Layout Positions (from powerwall-monitor.yml design)
+// UI Layout (from powerwall-monitor.yml design). Positions live in the
+// constexpr tables below, one column per layout variant.
 #define LABEL_HEIGHT 28
 #define LABEL_HEIGHT_LARGE 39
 #define ICON_WIDTH 70
 #define ICON_HEIGHT 70
+#define ICON_CORNER_RADIUS 17  // Rounded tile corners in the icon SVGs
+#define VALUE_WIDTH 100   // Side value labels (grid, home, EV, extra nodes)
+
+enum DashLayout : uint8_t {
+    DASH_LAYOUT_DEFAULT = 0,
+    DASH_LAYOUT_EV,       // EV charger icon and labels shown
+    DASH_LAYOUT_COUNT
+};
+
+// Icons baked into the background layer, plus the extra node badge slots
+enum DashIcon : uint8_t {
+    DASH_ICON_SOLAR = 0,
+    DASH_ICON_GRID,
+    DASH_ICON_HOME,
+    DASH_ICON_BATTERY,
+    DASH_ICON_CENTER,
+    DASH_ICON_EV,
+    DASH_ICON_EXTRA_1,
+    DASH_ICON_EXTRA_2,
+    DASH_ICON_EXTRA_3,
+    DASH_ICON_COUNT
+};
+
+enum DashWidgetKind : uint8_t {
+    DASH_GLYPH_LABEL,  // Cached glyph label (value fonts)
+    DASH_LABEL,        // Plain lv_label
+    DASH_BAR           // SOC bar
+};
+
+struct DashRect {
+    int16_t x, y, w, h;  // h 0 = content height
+};
+
+struct DashWidgetSpec {
+    lv_obj_t **obj;          // Created object is stored here
+    WidgetView *view;        // View-model cache to bind, or nullptr
+    DashWidgetKind kind;
+    const lv_font_t *font;   // Glyph labels
+    lv_style_t *style;
+    lv_style_t *align;       // Extra alignment style, or nullptr
+    bool gray_accent;        // Unit suffix in gray
+    bool hidden;             // Until data (or a variant) shows it
+    const char *text;
+    DashRect rect[DASH_LAYOUT_COUNT];
+};
+
+constexpr bool operator==(const DashRect &a, const DashRect &b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
 
-// Icon positions (default - EV disabled)
-#define SOLAR_ICON_X    205
-#define SOLAR_ICON_Y    31
-#define GRID_ICON_X     77
-#define GRID_ICON_Y     159
-#define HOME_ICON_X     333
-#define HOME_ICON_Y     159
-#define BATTERY_ICON_X  206
-#define BATTERY_ICON_Y  265
-#define CENTER_ICON_X   209
-#define CENTER_ICON_Y   163
-#define EV_ICON_X       333
-#define EV_ICON_Y       31
-
-// Icon positions when EV is enabled (adjusted for spacing)
-#define HOME_ICON_X_EV  333
-#define HOME_ICON_Y_EV  159
-#define EV_ICON_X_EV    333
-#define EV_ICON_Y_EV    31
-
-// Animation path centers (static positions - computed from icon positions)
-#define SOLAR_CENTER_X   (SOLAR_ICON_X + ICON_WIDTH / 2)
-#define SOLAR_CENTER_Y   (SOLAR_ICON_Y + ICON_HEIGHT / 2)
-#define GRID_CENTER_X    (GRID_ICON_X + ICON_WIDTH / 2)
-#define GRID_CENTER_Y    (GRID_ICON_Y + ICON_HEIGHT / 2)
-#define BATTERY_CENTER_X (BATTERY_ICON_X + ICON_WIDTH / 2)
-#define BATTERY_CENTER_Y (BATTERY_ICON_Y + ICON_HEIGHT / 2)
-#define CENTER_X         (CENTER_ICON_X + ICON_WIDTH / 2)
-#define CENTER_Y         (CENTER_ICON_Y + ICON_HEIGHT / 2)
-
-// Value label positions (default - EV disabled)
-#define BATTERY_VAL_Y 345
-#define SOLAR_VAL_Y (SOLAR_ICON_Y + 80)
-#define GRID_VAL_X 62
-#define GRID_VAL_Y 240
-#define GRID_VAL_WIDTH 100
-#define HOME_VAL_X 318
-#define HOME_VAL_Y 240
-#define HOME_VAL_WIDTH 100
-
-// Value label positions when EV is enabled
-#define HOME_VAL_X_EV   318
-#define HOME_VAL_Y_EV   240
-#define EV_VAL_X_EV     318
-#define EV_VAL_Y_EV     (EV_ICON_Y_EV + 80)
-
-#define SOC_LABEL_Y 413
-#define SOC_OFFGRID_X 84
-#define SOC_OFFGRID_WIDTH 94
-#define TIME_REMAINING_X 150
-#define TIME_REMAINING_WIDTH 250
-#define SOC_BAR_X 82
-#define SOC_BAR_Y 454
-#define SOC_BAR_WIDTH 316
-#define SOC_BAR_HEIGHT 13
-
-// Theme colors (matching ESPHome config)
+// Theme colors (matching ESPHome config); flow, bar and label colors are in ui_styles.cpp
 #define COLOR_BG        0x0A0C10
-#define COLOR_WHITE     0xFFFFFF
-#define COLOR_GRID      0x8A8A8A
-#define COLOR_SOLAR     0xFFD54A
-#define COLOR_HOME      0x4FC3F7
-#define COLOR_BATTERY   0x64DD17
-#define COLOR_BAR_BG    0x16181C
-#define COLOR_BAR_FILL  0x22C55E
-#define COLOR_GRAY      0x6A6A6A  // Used for dimmed text in recolor mode
-#define COLOR_EV        0x06B6D4  // Cyan for EV charger
-
-// EV value label positions
-#define EV_VAL_X        318
-#define EV_VAL_Y        (EV_ICON_Y + 80)
-#define EV_VAL_WIDTH    100
+#define COLOR_GRAY      0x6A6A6A  // Used for dimmed unit suffixes
 
 // Animation timing constants
-#define ANIMATION_FRAME_MS  33  // ~30 FPS (matches ESPHome 33ms update_interval)
+// Adaptive rate: full rate only for a lit dashboard with flows moving faster
+// than the minimum speed; no updates while another screen covers it
+#define ANIMATION_FRAME_MS         33   // ~30 FPS (matches ESPHome 33ms update_interval)
+#define ANIMATION_FRAME_MS_SLOW    50   // Flows below ANIMATION_SLOW_FLOW_W (~2 px per frame)
+#define ANIMATION_FRAME_MS_DIMMED  100  // Backlight dimmed (idle or night brightness)
+#define ANIMATION_FRAME_MS_IDLE    250  // No active flows: only poll for one to start
+#define ANIMATION_SLOW_FLOW_W      450.0f  // Below this dots move at the minimum speed
 
 // Buffer sizes for string formatting
 #define BUFFER_SIZE_SMALL   32
@@ -111,58 +103,78 @@ static lv_obj_t *lbl_soc_offgrid = nullptr;
 static lv_obj_t *lbl_time_remaining = nullptr;
 static lv_obj_t *bar_soc = nullptr;
 
-// Disable overlays for icons
-static lv_obj_t *img_solar_disabled = nullptr;
-static lv_obj_t *img_grid_disabled = nullptr;
-static lv_obj_t *img_battery_disabled = nullptr;
+// Pre-composited background layer (background color + all icons) in PSRAM
+static lv_obj_t *bg_canvas = nullptr;
+static lv_color_t *bg_canvas_buf = nullptr;
 
-// Icon images
-static lv_obj_t *img_solar = nullptr;
-static lv_obj_t *img_grid = nullptr;
-static lv_obj_t *img_grid_offline = nullptr;
-static lv_obj_t *img_home = nullptr;
-static lv_obj_t *img_battery = nullptr;
-static lv_obj_t *img_center = nullptr;
+// Without PSRAM for the layer, the icons are image objects above the flow
+// dots instead (one per icon drawn, including the off-grid overlay)
+#define MAX_BG_ICONS 7
+static lv_obj_t *bg_icon_imgs[MAX_BG_ICONS] = {nullptr};
 
 // EV charger elements (hidden by default)
-static lv_obj_t *img_ev = nullptr;
-static lv_obj_t *img_ev_disabled = nullptr;
 static lv_obj_t *lbl_ev_val = nullptr;
 static lv_obj_t *lbl_ev_soc = nullptr;
 
 // Data RX indicator dot
 static lv_obj_t *dot_data_rx = nullptr;
 
+// "Last known" marker shown while values are restored from the last session
+static lv_obj_t *lbl_stale = nullptr;
+
+// Labels dimmed (UI_STATE_STALE) while showing restored values
+static lv_obj_t **const stale_labels[] = {
+    &lbl_solar_val, &lbl_grid_val, &lbl_home_val, &lbl_batt_val, &lbl_ev_val,
+    &lbl_ev_soc, &lbl_soc, &lbl_soc_offgrid, &lbl_time_remaining
+};
+
+// Cached widget output - update functions only touch LVGL on real change
+static WidgetView view_solar_val;
+static WidgetView view_grid_val;
+static WidgetView view_home_val;
+static WidgetView view_batt_val;
+static WidgetView view_soc;
+static WidgetView view_soc_offgrid;
+static WidgetView view_time_remaining;
+static WidgetView view_ev_val;
+static WidgetView view_ev_soc;
+static WidgetView view_data_rx;
+
 // Info button
 static lv_obj_t *btn_info = nullptr;
 
-// Animated dots for power flow visualization (3 dots per flow path)
-static lv_obj_t *dot_solar_home = nullptr;
-static lv_obj_t *dot_solar_home_2 = nullptr;
-static lv_obj_t *dot_solar_home_3 = nullptr;
-static lv_obj_t *dot_solar_batt = nullptr;
-static lv_obj_t *dot_solar_batt_2 = nullptr;
-static lv_obj_t *dot_solar_batt_3 = nullptr;
-static lv_obj_t *dot_solar_grid = nullptr;
-static lv_obj_t *dot_solar_grid_2 = nullptr;
-static lv_obj_t *dot_solar_grid_3 = nullptr;
-static lv_obj_t *dot_grid_home = nullptr;
-static lv_obj_t *dot_grid_home_2 = nullptr;
-static lv_obj_t *dot_grid_home_3 = nullptr;
-static lv_obj_t *dot_grid_batt = nullptr;
-static lv_obj_t *dot_grid_batt_2 = nullptr;
-static lv_obj_t *dot_grid_batt_3 = nullptr;
-static lv_obj_t *dot_batt_home = nullptr;
-static lv_obj_t *dot_batt_home_2 = nullptr;
-static lv_obj_t *dot_batt_home_3 = nullptr;
-static lv_obj_t *dot_batt_grid = nullptr;
-static lv_obj_t *dot_batt_grid_2 = nullptr;
-static lv_obj_t *dot_batt_grid_3 = nullptr;
-
-// EV flow dots (Home -> EV)
-static lv_obj_t *dot_home_ev = nullptr;
-static lv_obj_t *dot_home_ev_2 = nullptr;
-static lv_obj_t *dot_home_ev_3 = nullptr;
+// Animated dots for power flow visualization, handed out to the solved
+// edges each frame (FLOW_DOTS_PER_EDGE dots per edge)
+#define FLOW_DOT_EDGES      10
+#define FLOW_DOTS_PER_EDGE  3
+#define FLOW_DOT_COUNT      (FLOW_DOT_EDGES * FLOW_DOTS_PER_EDGE)
+static lv_obj_t *flow_dots[FLOW_DOT_COUNT];
+static lv_style_t *flow_dot_styles[FLOW_DOT_COUNT];  // Color style currently on each dot
+static uint8_t flow_dots_used = 0;                    // Dots placed by the last frame
+
+// Extra flow nodes (generator, more batteries, EV chargers) drawn as badges in free slots
+#define EXTRA_BADGE_SIZE 56
+struct ExtraNodeView {
+    PowerNodeRole role;
+    float w;
+    uint8_t node;          // Index in the flow topology
+    lv_obj_t *badge;
+    lv_style_t *badge_style;  // Role color
+    lv_obj_t *badge_label;
+    lv_obj_t *value_label;
+    WidgetView view_value;
+};
+static ExtraNodeView g_extra_nodes[MQTT_MAX_EXTRA_NODES];
+static uint8_t g_extra_count = 0;
+
+// Flow topology and the icon center of each node
+static PowerTopology g_topology;
+static lv_point_t g_node_centers[POWER_FLOW_MAX_NODES];
+static uint8_t g_node_solar = POWER_NODE_NONE;
+static uint8_t g_node_grid = POWER_NODE_NONE;
+static uint8_t g_node_home = POWER_NODE_NONE;
+static uint8_t g_node_battery = POWER_NODE_NONE;
+static uint8_t g_node_ev = POWER_NODE_NONE;
 
 // Forward declaration for info button callback
 static void info_btn_event_cb(lv_event_t *e);
@@ -175,6 +187,10 @@ static unsigned long last_pulse_update_ms = 0;  // Throttle pulse updates
 // Track if we've received data (to hide config screen)
 static bool mqtt_data_received = false;
 
+// Restored values are shown dimmed until the first fresh update
+static bool g_restoring = false;
+static bool g_stale = false;
+
 // Power flow animation state
 static float g_grid_w = 0.0f;
 static float g_home_w = 0.0f;
@@ -183,6 +199,8 @@ static float g_batt_w = 0.0f;
 static float g_soc = 0.0f;
 static float ph_master = 0.0f;
 static unsigned long g_last_anim_ms = 0;
+static uint32_t g_anim_frame_ms = ANIMATION_FRAME_MS;  // Chosen by the last frame
+static bool g_dimmed = false;                          // Backlight below day brightness
 static bool g_offgrid = false;
 static float g_time_remaining = 0.0f;
 
@@ -192,246 +210,285 @@ static float g_ev_w = 0.0f;
 static bool g_ev_connected = false;
 static float g_ev_soc = 0.0f;
 
-// Dynamic animation center positions (updated when EV is enabled/disabled)
-static int g_home_center_x = HOME_ICON_X + ICON_WIDTH / 2;
-static int g_home_center_y = HOME_ICON_Y + ICON_HEIGHT / 2;
-static int g_ev_center_x = EV_ICON_X + ICON_WIDTH / 2;
-static int g_ev_center_y = EV_ICON_Y + ICON_HEIGHT / 2;
+// ============== Layout Tables ==============
+
+// Icon top-left corners per variant
+static constexpr lv_point_t dash_icons[DASH_ICON_COUNT][DASH_LAYOUT_COUNT] = {
+    //                    default        EV
+    /* SOLAR    */ { { 205, 31 },  { 205, 31 } },
+    /* GRID     */ { { 77, 159 },  { 77, 159 } },
+    /* HOME     */ { { 333, 159 }, { 333, 159 } },
+    /* BATTERY  */ { { 206, 265 }, { 206, 265 } },
+    /* CENTER   */ { { 209, 163 }, { 209, 163 } },
+    /* EV       */ { { 333, 31 },  { 333, 31 } },
+    /* EXTRA_1  */ { { 77, 31 },   { 77, 31 } },    // Top left
+    /* EXTRA_2  */ { { 77, 265 },  { 77, 265 } },   // Bottom left
+    /* EXTRA_3  */ { { 333, 265 }, { 333, 265 } },  // Bottom right
+};
+
+static_assert(DASH_ICON_EXTRA_3 - DASH_ICON_EXTRA_1 + 1 == MQTT_MAX_EXTRA_NODES, "one icon slot per extra node");
+
+// Value labels and the SOC bar, created in this order by buildDashboardWidgets()
+static constexpr DashWidgetSpec dash_widgets[] = {
+    // Battery value - centered at bottom
+    { &lbl_batt_val, &view_batt_val, DASH_GLYPH_LABEL, &space_bold_21, &ui_style_value_label, nullptr, false, false, "0.0 kW",
+      { { 0, 345, TFT_WIDTH, LABEL_HEIGHT }, { 0, 345, TFT_WIDTH, LABEL_HEIGHT } } },
+    // Solar value - centered below the solar icon
+    { &lbl_solar_val, &view_solar_val, DASH_GLYPH_LABEL, &space_bold_21, &ui_style_value_label, nullptr, false, false, "0.0 kW",
+      { { 0, 111, TFT_WIDTH, LABEL_HEIGHT }, { 0, 111, TFT_WIDTH, LABEL_HEIGHT } } },
+    // Grid value - left side
+    { &lbl_grid_val, &view_grid_val, DASH_GLYPH_LABEL, &space_bold_21, &ui_style_value_label, nullptr, false, false, "0.0 kW",
+      { { 62, 240, VALUE_WIDTH, LABEL_HEIGHT }, { 62, 240, VALUE_WIDTH, LABEL_HEIGHT } } },
+    // Home value - right side
+    { &lbl_home_val, &view_home_val, DASH_GLYPH_LABEL, &space_bold_21, &ui_style_value_label, nullptr, false, false, "0.0 kW",
+      { { 318, 240, VALUE_WIDTH, LABEL_HEIGHT }, { 318, 240, VALUE_WIDTH, LABEL_HEIGHT } } },
+    // EV value (shown by setEVEnabled)
+    { &lbl_ev_val, &view_ev_val, DASH_GLYPH_LABEL, &space_bold_21, &ui_style_value_label, nullptr, false, true, "0.0 kW",
+      { { 318, 111, VALUE_WIDTH, LABEL_HEIGHT }, { 318, 111, VALUE_WIDTH, LABEL_HEIGHT } } },
+    // EV SOC - smaller, below the EV value
+    { &lbl_ev_soc, &view_ev_soc, DASH_LABEL, nullptr, &ui_style_ev_soc, nullptr, false, true, "",
+      { { 318, 111 + LABEL_HEIGHT, VALUE_WIDTH, 0 }, { 318, 111 + LABEL_HEIGHT, VALUE_WIDTH, 0 } } },
+    // SOC percentage - centered above the battery bar
+    { &lbl_soc, &view_soc, DASH_GLYPH_LABEL, &space_bold_30, &ui_style_value_label, nullptr, false, false, "0%",
+      { { 0, 413, TFT_WIDTH, LABEL_HEIGHT_LARGE }, { 0, 413, TFT_WIDTH, LABEL_HEIGHT_LARGE } } },
+    // Off-grid SOC - left-aligned, gray unit
+    { &lbl_soc_offgrid, &view_soc_offgrid, DASH_GLYPH_LABEL, &space_bold_30, &ui_style_value_label, &ui_style_align_left, true, true, "0%",
+      { { 84, 413, 94, LABEL_HEIGHT_LARGE }, { 84, 413, 94, LABEL_HEIGHT_LARGE } } },
+    // Off-grid time remaining - right-aligned, gray unit
+    { &lbl_time_remaining, &view_time_remaining, DASH_GLYPH_LABEL, &space_bold_30, &ui_style_value_label, &ui_style_align_right, true, true, "",
+      { { 150, 413, 250, LABEL_HEIGHT_LARGE }, { 150, 413, 250, LABEL_HEIGHT_LARGE } } },
+    // SOC bar
+    { &bar_soc, nullptr, DASH_BAR, nullptr, &ui_style_bar_main, nullptr, false, false, nullptr,
+      { { 82, 454, 316, 13 }, { 82, 454, 316, 13 } } },
+};
+
+static DashLayout g_layout = DASH_LAYOUT_DEFAULT;
+
+static lv_point_t iconPos(DashIcon icon) {
+    return dash_icons[icon][g_layout];
+}
+
+static lv_point_t iconCenter(DashIcon icon) {
+    const lv_point_t &pos = dash_icons[icon][g_layout];
+    return { (lv_coord_t)(pos.x + ICON_WIDTH / 2), (lv_coord_t)(pos.y + ICON_HEIGHT / 2) };
+}
+
+static lv_point_t extraNodeSlot(uint8_t index) {
+    return iconPos((DashIcon)(DASH_ICON_EXTRA_1 + index));
+}
+
+// Icon states baked into the background layer
+static bool g_solar_idle = false;
+static bool g_grid_idle = false;
+static bool g_batt_idle = false;
+static bool g_ev_idle = false;
+static bool g_ev_dimmed = false;
+
+// Background state bits - the layer is only recomposed when these change
+#define BG_SOLAR_IDLE   (1 << 0)
+#define BG_GRID_IDLE    (1 << 1)
+#define BG_BATT_IDLE    (1 << 2)
+#define BG_GRID_OFFLINE (1 << 3)
+#define BG_EV_ENABLED   (1 << 4)
+#define BG_EV_IDLE      (1 << 5)
+#define BG_EV_DIMMED    (1 << 6)
+#define BG_STATE_NONE   0xFFFFFFFFUL
+
+static uint32_t bg_state = BG_STATE_NONE;
+
+// Icon shapes in the background layer; flow dots are hidden while inside
+// one so they still appear to pass underneath the icons
+struct BgOccluder {
+    lv_area_t area;
+    lv_coord_t radius;  // Corner radius (half the width for a circle)
+};
+
+#define MAX_BG_OCCLUDERS (8 + MQTT_MAX_EXTRA_NODES)
+static BgOccluder bg_occluders[MAX_BG_OCCLUDERS];
+static int bg_occluder_count = 0;
+
+static void composeBackground();
+static void rebuildFlowTopology();
+static void buildDashboardWidgets();
+static void applyExtraNodeWidgets();
+
+// Instantiate every table widget at its position in the current variant
+static void buildDashboardWidgets() {
+    for (const DashWidgetSpec &spec : dash_widgets) {
+        const DashRect &rect = spec.rect[g_layout];
+        lv_obj_t *obj = nullptr;
+
+        switch (spec.kind) {
+            case DASH_GLYPH_LABEL:
+                obj = createGlyphLabel(main_screen, spec.font);
+                setGlyphLabelText(obj, spec.text);
+                break;
+            case DASH_LABEL:
+                obj = lv_label_create(main_screen);
+                lv_label_set_text(obj, spec.text);
+                break;
+            case DASH_BAR:
+                obj = lv_bar_create(main_screen);
+                lv_bar_set_range(obj, 0, 100);
+                lv_bar_set_value(obj, 0, LV_ANIM_OFF);
+                lv_obj_add_style(obj, &ui_style_bar_indicator, LV_PART_INDICATOR);
+                break;
+        }
+
+        lv_obj_add_style(obj, spec.style, LV_PART_MAIN);
+        if (spec.align) lv_obj_add_style(obj, spec.align, 0);
+        if (spec.gray_accent) setGlyphLabelAccentColor(obj, lv_color_hex(COLOR_GRAY));
+        lv_obj_set_pos(obj, rect.x, rect.y);
+        lv_obj_set_width(obj, rect.w);
+        if (rect.h > 0) lv_obj_set_height(obj, rect.h);
+        if (spec.hidden) lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+
+        *spec.obj = obj;
+        if (spec.view) viewBind(*spec.view, obj);
+    }
+}
+
+// Switch layout variant, touching only widgets and icons whose rectangle differs
+static void applyDashboardLayout(DashLayout layout) {
+    if (layout == g_layout) return;
+    const DashLayout previous = g_layout;
+    g_layout = layout;
+
+    int moved = 0;
+    for (const DashWidgetSpec &spec : dash_widgets) {
+        lv_obj_t *obj = *spec.obj;
+        const DashRect &from = spec.rect[previous];
+        const DashRect &to = spec.rect[layout];
+        if (!obj || from == to) continue;
+
+        if (from.x != to.x || from.y != to.y) lv_obj_set_pos(obj, to.x, to.y);
+        if (from.w != to.w) lv_obj_set_width(obj, to.w);
+        if (from.h != to.h) lv_obj_set_height(obj, to.h > 0 ? to.h : LV_SIZE_CONTENT);
+        moved++;
+    }
+
+    bool icons_moved = false;
+    for (uint8_t i = 0; i < DASH_ICON_COUNT; i++) {
+        const lv_point_t &from = dash_icons[i][previous];
+        const lv_point_t &to = dash_icons[i][layout];
+        if (from.x == to.x && from.y == to.y) continue;
+        icons_moved = true;
+        moved++;
+
+        if (i >= DASH_ICON_EXTRA_1) {
+            ExtraNodeView &extra = g_extra_nodes[i - DASH_ICON_EXTRA_1];
+            if (extra.badge) {
+                lv_obj_set_pos(extra.badge, to.x + (ICON_WIDTH - EXTRA_BADGE_SIZE) / 2,
+                               to.y + (ICON_HEIGHT - EXTRA_BADGE_SIZE) / 2);
+                lv_obj_set_pos(extra.value_label, to.x - 15, to.y + 80);
+            }
+        }
+    }
+
+    // Moved icons need a new background layer and new flow paths
+    if (icons_moved) {
+        bg_state = BG_STATE_NONE;
+        rebuildFlowTopology();
+    }
+
+    Serial.printf("Dashboard layout %d: %d element(s) moved\n", layout, moved);
+}
 
 void createMainDashboard() {
     // Main screen with dark background
     main_screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(main_screen, lv_color_hex(COLOR_BG), 0);
+    lv_obj_add_style(main_screen, &ui_style_screen, 0);
     lv_obj_clear_flag(main_screen, LV_OBJ_FLAG_SCROLLABLE);
     lv_scr_load(main_screen);
 
+    // ========== Static Background Layer (bottom-most, covers the whole screen) ==========
+    // One opaque image replaces the screen fill plus every icon blit per frame
+    bg_canvas_buf = (lv_color_t *)heap_caps_malloc(
+        LV_CANVAS_BUF_SIZE_TRUE_COLOR(TFT_WIDTH, TFT_HEIGHT), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (bg_canvas_buf) {
+        bg_canvas = lv_canvas_create(main_screen);
+        lv_canvas_set_buffer(bg_canvas, bg_canvas_buf, TFT_WIDTH, TFT_HEIGHT, LV_IMG_CF_TRUE_COLOR);
+        lv_obj_set_pos(bg_canvas, 0, 0);
+    } else {
+        Serial.println("Failed to allocate background layer, using icon images");
+    }
+
     // ========== Animated Power Flow Dots (created first so they appear under layout) ==========
-    // Helper lambda to create a dot
-    auto create_dot = [&](uint32_t color) -> lv_obj_t* {
+    for (int i = 0; i < FLOW_DOT_COUNT; i++) {
         lv_obj_t *dot = lv_obj_create(main_screen);
         lv_obj_set_size(dot, 12, 12);
-        lv_obj_set_style_radius(dot, 6, 0);
-        lv_obj_set_style_bg_color(dot, lv_color_hex(color), 0);
-        lv_obj_set_style_bg_opa(dot, LV_OPA_TRANSP, 0);
-        lv_obj_set_style_border_width(dot, 0, 0);
+        lv_obj_add_style(dot, &ui_style_dot, 0);
+        lv_obj_add_style(dot, &ui_style_dot_solar, 0);
         lv_obj_add_flag(dot, LV_OBJ_FLAG_FLOATING);
+        lv_obj_add_flag(dot, LV_OBJ_FLAG_HIDDEN);
         lv_obj_clear_flag(dot, LV_OBJ_FLAG_SCROLLABLE);
-        return dot;
-    };
-
-    // Solar flows (yellow dots)
-    dot_solar_home = create_dot(COLOR_SOLAR);
-    dot_solar_home_2 = create_dot(COLOR_SOLAR);
-    dot_solar_home_3 = create_dot(COLOR_SOLAR);
-    dot_solar_batt = create_dot(COLOR_SOLAR);
-    dot_solar_batt_2 = create_dot(COLOR_SOLAR);
-    dot_solar_batt_3 = create_dot(COLOR_SOLAR);
-    dot_solar_grid = create_dot(COLOR_SOLAR);
-    dot_solar_grid_2 = create_dot(COLOR_SOLAR);
-    dot_solar_grid_3 = create_dot(COLOR_SOLAR);
-
-    // Grid flows (gray dots)
-    dot_grid_home = create_dot(COLOR_GRID);
-    dot_grid_home_2 = create_dot(COLOR_GRID);
-    dot_grid_home_3 = create_dot(COLOR_GRID);
-    dot_grid_batt = create_dot(COLOR_GRID);
-    dot_grid_batt_2 = create_dot(COLOR_GRID);
-    dot_grid_batt_3 = create_dot(COLOR_GRID);
-
-    // Battery flows (green dots)
-    dot_batt_home = create_dot(COLOR_BATTERY);
-    dot_batt_home_2 = create_dot(COLOR_BATTERY);
-    dot_batt_home_3 = create_dot(COLOR_BATTERY);
-    dot_batt_grid = create_dot(COLOR_BATTERY);
-    dot_batt_grid_2 = create_dot(COLOR_BATTERY);
-    dot_batt_grid_3 = create_dot(COLOR_BATTERY);
-
-    // EV flows (cyan dots - from home to EV)
-    dot_home_ev = create_dot(COLOR_EV);
-    dot_home_ev_2 = create_dot(COLOR_EV);
-    dot_home_ev_3 = create_dot(COLOR_EV);
-
-    // ========== Icon Images (created after dots so dots appear underneath) ==========
-    img_solar = lv_img_create(main_screen);
-    lv_img_set_src(img_solar, &icon_solar_img);
-    lv_obj_set_pos(img_solar, SOLAR_ICON_X, SOLAR_ICON_Y);
-
-    img_solar_disabled = lv_img_create(main_screen);
-    lv_img_set_src(img_solar_disabled, &icon_solar_disabled_img);
-    lv_obj_set_pos(img_solar_disabled, SOLAR_ICON_X, SOLAR_ICON_Y);
-    lv_obj_add_flag(img_solar_disabled, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
-
-    img_grid = lv_img_create(main_screen);
-    lv_img_set_src(img_grid, &icon_grid_img);
-    lv_obj_set_pos(img_grid, GRID_ICON_X, GRID_ICON_Y);
-
-    img_grid_disabled = lv_img_create(main_screen);
-    lv_img_set_src(img_grid_disabled, &icon_grid_disabled_img);
-    lv_obj_set_pos(img_grid_disabled, GRID_ICON_X, GRID_ICON_Y);
-    lv_obj_add_flag(img_grid_disabled, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
-
-    img_home = lv_img_create(main_screen);
-    lv_img_set_src(img_home, &icon_home_img);
-    lv_obj_set_pos(img_home, HOME_ICON_X, HOME_ICON_Y);
-
-    img_battery = lv_img_create(main_screen);
-    lv_img_set_src(img_battery, &icon_battery_img);
-    lv_obj_set_pos(img_battery, BATTERY_ICON_X, BATTERY_ICON_Y);
-
-    img_battery_disabled = lv_img_create(main_screen);
-    lv_img_set_src(img_battery_disabled, &icon_battery_disabled_img);
-    lv_obj_set_pos(img_battery_disabled, BATTERY_ICON_X, BATTERY_ICON_Y);
-    lv_obj_add_flag(img_battery_disabled, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
-
-    img_center = lv_img_create(main_screen);
-    lv_img_set_src(img_center, &icon_center_img);
-    lv_obj_set_pos(img_center, CENTER_ICON_X, CENTER_ICON_Y);
-
-    // ========== EV Icon (hidden by default until enabled) ==========
-    img_ev = lv_img_create(main_screen);
-    lv_img_set_src(img_ev, &icon_ev_img);
-    lv_obj_set_pos(img_ev, EV_ICON_X, EV_ICON_Y);
-    lv_obj_add_flag(img_ev, LV_OBJ_FLAG_HIDDEN);
-
-    img_ev_disabled = lv_img_create(main_screen);
-    lv_img_set_src(img_ev_disabled, &icon_ev_disabled_img);
-    lv_obj_set_pos(img_ev_disabled, EV_ICON_X, EV_ICON_Y);
-    lv_obj_add_flag(img_ev_disabled, LV_OBJ_FLAG_HIDDEN);
-
-    // ========== POWER VALUE LABELS (using custom font space_bold_21) ==========
-    // Battery value - centered at bottom
-    lbl_batt_val = lv_label_create(main_screen);
-    lv_label_set_text(lbl_batt_val, "0.0 kW");
-    lv_obj_set_style_text_color(lbl_batt_val, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_batt_val, &space_bold_21, 0);
-    lv_obj_set_style_text_align(lbl_batt_val, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_pos(lbl_batt_val, 0, BATTERY_VAL_Y);
-    lv_obj_set_width(lbl_batt_val, TFT_WIDTH);
-    lv_obj_set_height(lbl_batt_val, LABEL_HEIGHT);
-
-    // Solar value - centered at top
-    lbl_solar_val = lv_label_create(main_screen);
-    lv_label_set_text(lbl_solar_val, "0.0 kW");
-    lv_obj_set_style_text_color(lbl_solar_val, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_solar_val, &space_bold_21, 0);
-    lv_obj_set_style_text_align(lbl_solar_val, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_pos(lbl_solar_val, 0, SOLAR_VAL_Y);
-    lv_obj_set_width(lbl_solar_val, TFT_WIDTH);
-    lv_obj_set_height(lbl_solar_val, LABEL_HEIGHT);
+        flow_dots[i] = dot;
+        flow_dot_styles[i] = &ui_style_dot_solar;
+    }
+    flow_dots_used = 0;
 
-    // Grid value - left side
-    lbl_grid_val = lv_label_create(main_screen);
-    lv_label_set_text(lbl_grid_val, "0.0 kW");
-    lv_obj_set_style_text_color(lbl_grid_val, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_grid_val, &space_bold_21, 0);
-    lv_obj_set_style_text_align(lbl_grid_val, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_pos(lbl_grid_val, GRID_VAL_X, GRID_VAL_Y);
-    lv_obj_set_width(lbl_grid_val, GRID_VAL_WIDTH);
-    lv_obj_set_height(lbl_grid_val, LABEL_HEIGHT);
+    // ========== Icon Images (only without the background layer; above the dots) ==========
+    if (!bg_canvas) {
+        for (int i = 0; i < MAX_BG_ICONS; i++) {
+            bg_icon_imgs[i] = lv_img_create(main_screen);
+            lv_obj_add_flag(bg_icon_imgs[i], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    composeBackground();
+
+    // ========== Extra Flow Node Badges (hidden until configured) ==========
+    for (uint8_t i = 0; i < MQTT_MAX_EXTRA_NODES; i++) {
+        ExtraNodeView &extra = g_extra_nodes[i];
+        const lv_point_t slot = extraNodeSlot(i);
+
+        extra.badge = lv_obj_create(main_screen);
+        extra.badge_style = nullptr;
+        lv_obj_set_size(extra.badge, EXTRA_BADGE_SIZE, EXTRA_BADGE_SIZE);
+        lv_obj_set_pos(extra.badge, slot.x + (ICON_WIDTH - EXTRA_BADGE_SIZE) / 2,
+                       slot.y + (ICON_HEIGHT - EXTRA_BADGE_SIZE) / 2);
+        lv_obj_add_style(extra.badge, &ui_style_node_badge, 0);
+        lv_obj_clear_flag(extra.badge, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_flag(extra.badge, LV_OBJ_FLAG_HIDDEN);
+
+        extra.badge_label = lv_label_create(extra.badge);
+        lv_obj_add_style(extra.badge_label, &ui_style_info_value, 0);
+        lv_obj_center(extra.badge_label);
+
+        extra.value_label = createGlyphLabel(main_screen, &space_bold_21);
+        setGlyphLabelText(extra.value_label, "0.0 kW");
+        lv_obj_add_style(extra.value_label, &ui_style_value_label, 0);
+        lv_obj_set_pos(extra.value_label, slot.x - 15, slot.y + 80);
+        lv_obj_set_width(extra.value_label, VALUE_WIDTH);
+        lv_obj_set_height(extra.value_label, LABEL_HEIGHT);
+        lv_obj_add_flag(extra.value_label, LV_OBJ_FLAG_HIDDEN);
+        viewBind(extra.view_value, extra.value_label);
+    }
 
-    // Home value - right side
-    lbl_home_val = lv_label_create(main_screen);
-    lv_label_set_text(lbl_home_val, "0.0 kW");
-    lv_obj_set_style_text_color(lbl_home_val, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_home_val, &space_bold_21, 0);
-    lv_obj_set_style_text_align(lbl_home_val, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_pos(lbl_home_val, HOME_VAL_X, HOME_VAL_Y);
-    lv_obj_set_width(lbl_home_val, HOME_VAL_WIDTH);
-    lv_obj_set_height(lbl_home_val, LABEL_HEIGHT);
-
-    // EV value label (hidden by default)
-    lbl_ev_val = lv_label_create(main_screen);
-    lv_label_set_text(lbl_ev_val, "0.0 kW");
-    lv_obj_set_style_text_color(lbl_ev_val, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_ev_val, &space_bold_21, 0);
-    lv_obj_set_style_text_align(lbl_ev_val, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_pos(lbl_ev_val, EV_VAL_X, EV_VAL_Y);
-    lv_obj_set_width(lbl_ev_val, EV_VAL_WIDTH);
-    lv_obj_set_height(lbl_ev_val, LABEL_HEIGHT);
-    lv_obj_add_flag(lbl_ev_val, LV_OBJ_FLAG_HIDDEN);
-
-    // EV SOC label (smaller, below EV value, hidden by default)
-    lbl_ev_soc = lv_label_create(main_screen);
-    lv_label_set_text(lbl_ev_soc, "");
-    lv_obj_set_style_text_color(lbl_ev_soc, lv_color_hex(COLOR_EV), 0);
-    lv_obj_set_style_text_font(lbl_ev_soc, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_align(lbl_ev_soc, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_pos(lbl_ev_soc, EV_VAL_X, EV_VAL_Y + LABEL_HEIGHT);
-    lv_obj_set_width(lbl_ev_soc, EV_VAL_WIDTH);
-    lv_obj_add_flag(lbl_ev_soc, LV_OBJ_FLAG_HIDDEN);
-
-    // ========== SOC Label (using custom font space_bold_30) ==========
-    // SOC percentage - centered above battery bar
-    lbl_soc = lv_label_create(main_screen);
-    lv_label_set_text(lbl_soc, "0%");
-    lv_obj_set_style_text_color(lbl_soc, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_soc, &space_bold_30, 0);
-    lv_obj_set_style_text_align(lbl_soc, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_set_pos(lbl_soc, 0, SOC_LABEL_Y);
-    lv_obj_set_width(lbl_soc, TFT_WIDTH);
-    lv_obj_set_height(lbl_soc, LABEL_HEIGHT_LARGE);
-
-    // ========== Off-Grid SOC Label (left-aligned, hidden by default) ==========
-    lbl_soc_offgrid = lv_label_create(main_screen);
-    lv_label_set_text(lbl_soc_offgrid, "0%");
-    lv_obj_set_style_text_color(lbl_soc_offgrid, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_soc_offgrid, &space_bold_30, 0);
-    lv_obj_set_style_text_align(lbl_soc_offgrid, LV_TEXT_ALIGN_LEFT, 0);
-    lv_obj_set_pos(lbl_soc_offgrid, SOC_OFFGRID_X, SOC_LABEL_Y);
-    lv_obj_set_width(lbl_soc_offgrid, SOC_OFFGRID_WIDTH);
-    lv_obj_set_height(lbl_soc_offgrid, LABEL_HEIGHT_LARGE);
-    lv_label_set_recolor(lbl_soc_offgrid, true);  // Enable recolor for multi-color text
-    lv_obj_add_flag(lbl_soc_offgrid, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
-
-    // ========== Time Remaining Label (right-aligned, hidden by default) ==========
-    lbl_time_remaining = lv_label_create(main_screen);
-    lv_label_set_text(lbl_time_remaining, "");
-    lv_obj_set_style_text_color(lbl_time_remaining, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(lbl_time_remaining, &space_bold_30, 0);
-    lv_obj_set_style_text_align(lbl_time_remaining, LV_TEXT_ALIGN_RIGHT, 0);
-    lv_obj_set_pos(lbl_time_remaining, TIME_REMAINING_X, SOC_LABEL_Y);
-    lv_obj_set_width(lbl_time_remaining, TIME_REMAINING_WIDTH);
-    lv_obj_set_height(lbl_time_remaining, LABEL_HEIGHT_LARGE);
-    lv_label_set_recolor(lbl_time_remaining, true);  // Enable recolor for multi-color text
-    lv_obj_add_flag(lbl_time_remaining, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
-
-    // ========== SOC Bar ==========
-    bar_soc = lv_bar_create(main_screen);
-    lv_obj_set_size(bar_soc, SOC_BAR_WIDTH, SOC_BAR_HEIGHT);
-    lv_obj_set_pos(bar_soc, SOC_BAR_X, SOC_BAR_Y);
-    lv_bar_set_range(bar_soc, 0, 100);
-    lv_bar_set_value(bar_soc, 0, LV_ANIM_OFF);
-
-    // Bar background style
-    lv_obj_set_style_bg_color(bar_soc, lv_color_hex(COLOR_BAR_BG), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(bar_soc, LV_OPA_30, LV_PART_MAIN);
-    lv_obj_set_style_border_width(bar_soc, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_color(bar_soc, lv_color_hex(0x5A5A5A), LV_PART_MAIN);
-    lv_obj_set_style_radius(bar_soc, 2, LV_PART_MAIN);
-
-    // Bar indicator style
-    lv_obj_set_style_bg_color(bar_soc, lv_color_hex(COLOR_BAR_FILL), LV_PART_INDICATOR);
-    lv_obj_set_style_bg_opa(bar_soc, LV_OPA_COVER, LV_PART_INDICATOR);
-    lv_obj_set_style_radius(bar_soc, 2, LV_PART_INDICATOR);
-
-    // ========== Grid Offline Overlay ==========
-    img_grid_offline = lv_img_create(main_screen);
-    lv_img_set_src(img_grid_offline, &icon_grid_offline_img);
-    lv_obj_set_pos(img_grid_offline, GRID_ICON_X, GRID_ICON_Y);
-    lv_obj_add_flag(img_grid_offline, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
+    // ========== Value Labels and SOC Bar (from the layout table) ==========
+    buildDashboardWidgets();
 
     // ========== Data RX Indicator Dot ==========
     dot_data_rx = lv_obj_create(main_screen);
     lv_obj_set_size(dot_data_rx, 10, 10);
     lv_obj_set_pos(dot_data_rx, 10, TFT_HEIGHT - 20);
-    lv_obj_set_style_radius(dot_data_rx, 5, 0);
-    lv_obj_set_style_bg_color(dot_data_rx, lv_color_hex(0xFF0000), 0);
-    lv_obj_set_style_bg_opa(dot_data_rx, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_width(dot_data_rx, 0, 0);
+    lv_obj_add_style(dot_data_rx, &ui_style_dot, 0);
+    lv_obj_add_style(dot_data_rx, &ui_style_dot_rx, 0);
     lv_obj_add_flag(dot_data_rx, LV_OBJ_FLAG_HIDDEN);
     lv_obj_add_flag(dot_data_rx, LV_OBJ_FLAG_FLOATING);
     lv_obj_clear_flag(dot_data_rx, LV_OBJ_FLAG_SCROLLABLE);
 
+    // ========== Stale Data Marker (top right, hidden until values are restored) ==========
+    lbl_stale = lv_label_create(main_screen);
+    lv_label_set_text(lbl_stale, "Last known");
+    lv_obj_add_style(lbl_stale, &ui_style_header, 0);
+    lv_obj_align(lbl_stale, LV_ALIGN_TOP_RIGHT, -10, 8);
+    lv_obj_add_flag(lbl_stale, LV_OBJ_FLAG_HIDDEN);
+
+    // Value labels dim while showing restored values
+    for (lv_obj_t **label : stale_labels) {
+        lv_obj_add_style(*label, &ui_style_stale, UI_STATE_STALE);
+    }
+
     // ========== Info Button (top right corner) ==========
     btn_info = lv_imgbtn_create(main_screen);
     lv_imgbtn_set_src(btn_info, LV_IMGBTN_STATE_RELEASED, NULL, &info_icon_img, NULL);
@@ -439,6 +496,12 @@ void createMainDashboard() {
     lv_obj_set_pos(btn_info, 10, 10);
     lv_obj_add_event_cb(btn_info, info_btn_event_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_add_flag(btn_info, LV_OBJ_FLAG_FLOATING);
+
+    // ========== Bind view-model caches (table widgets are bound by the builder) ==========
+    viewBind(view_data_rx, dot_data_rx);
+
+    applyExtraNodeWidgets();
+    rebuildFlowTopology();
 }
 
 static void info_btn_event_cb(lv_event_t *e) {
@@ -449,15 +512,151 @@ lv_obj_t* getMainScreen() {
     return main_screen;
 }
 
+// ============== Static Background Layer ==============
+
+static uint32_t currentBackgroundState() {
+    uint32_t state = 0;
+    if (g_solar_idle) state |= BG_SOLAR_IDLE;
+    if (g_grid_idle) state |= BG_GRID_IDLE;
+    if (g_batt_idle) state |= BG_BATT_IDLE;
+    if (g_offgrid) state |= BG_GRID_OFFLINE;
+    if (g_ev_enabled) {
+        state |= BG_EV_ENABLED;
+        if (g_ev_idle) state |= BG_EV_IDLE;
+        if (g_ev_dimmed) state |= BG_EV_DIMMED;
+    }
+    return state;
+}
+
+// Redraw the background layer (or place the icon images) if any icon state
+// changed since the last compose
+static void composeBackground() {
+    if (!bg_canvas && !bg_icon_imgs[0]) return;
+
+    const uint32_t state = currentBackgroundState();
+    if (state == bg_state) return;
+    bg_state = state;
+
+    const unsigned long start_us = micros();
+    bg_occluder_count = 0;
+    int icon_imgs_used = 0;
+
+    if (bg_canvas) lv_canvas_fill_bg(bg_canvas, lv_color_hex(COLOR_BG), LV_OPA_COVER);
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+
+    // Tiles are rounded squares, the center icon is a circle; the off-grid
+    // overlay's status mark past the tile is left out
+    auto draw_icon = [&](const lv_img_dsc_t *src, DashIcon icon, lv_opa_t opa) {
+        const lv_point_t pos = iconPos(icon);
+        const int x = pos.x, y = pos.y;
+        if (bg_canvas) {
+            img_dsc.opa = opa;
+            lv_canvas_draw_img(bg_canvas, x, y, src, &img_dsc);
+        } else if (icon_imgs_used < MAX_BG_ICONS) {
+            lv_obj_t *img = bg_icon_imgs[icon_imgs_used++];
+            lv_img_set_src(img, src);
+            lv_obj_set_pos(img, x, y);
+            lv_obj_set_style_opa(img, opa, 0);
+            lv_obj_clear_flag(img, LV_OBJ_FLAG_HIDDEN);
+        }
+
+        if (bg_occluder_count < MAX_BG_OCCLUDERS) {
+            const int w = min((int)src->header.w, ICON_WIDTH);
+            const int h = min((int)src->header.h, ICON_HEIGHT);
+            BgOccluder &occluder = bg_occluders[bg_occluder_count++];
+            occluder.area.x1 = x;
+            occluder.area.y1 = y;
+            occluder.area.x2 = x + w - 1;
+            occluder.area.y2 = y + h - 1;
+            occluder.radius = icon == DASH_ICON_CENTER ? w / 2 : ICON_CORNER_RADIUS;
+        }
+    };
+
+    // Disabled variants are full opaque replacements of the normal icons
+    draw_icon(g_solar_idle ? &icon_solar_disabled_img : &icon_solar_img, DASH_ICON_SOLAR, LV_OPA_COVER);
+    draw_icon(g_grid_idle ? &icon_grid_disabled_img : &icon_grid_img, DASH_ICON_GRID, LV_OPA_COVER);
+    draw_icon(g_batt_idle ? &icon_battery_disabled_img : &icon_battery_img, DASH_ICON_BATTERY, LV_OPA_COVER);
+    draw_icon(&icon_home_img, DASH_ICON_HOME, LV_OPA_COVER);
+    draw_icon(&icon_center_img, DASH_ICON_CENTER, LV_OPA_COVER);
+
+    if (g_ev_enabled) {
+        if (g_ev_idle) {
+            draw_icon(&icon_ev_disabled_img, DASH_ICON_EV, LV_OPA_COVER);
+        } else {
+            draw_icon(&icon_ev_img, DASH_ICON_EV, g_ev_dimmed ? LV_OPA_50 : LV_OPA_COVER);
+        }
+    }
+
+    if (g_offgrid) {
+        draw_icon(&icon_grid_offline_img, DASH_ICON_GRID, LV_OPA_COVER);
+    }
+
+    for (int i = icon_imgs_used; i < MAX_BG_ICONS && bg_icon_imgs[i]; i++) {
+        lv_obj_add_flag(bg_icon_imgs[i], LV_OBJ_FLAG_HIDDEN);
+    }
+
+    // Extra node badges (circles) are widgets, but dots still pass underneath them
+    for (uint8_t i = 0; i < g_extra_count && bg_occluder_count < MAX_BG_OCCLUDERS; i++) {
+        BgOccluder &occluder = bg_occluders[bg_occluder_count++];
+        const lv_point_t slot = extraNodeSlot(i);
+        occluder.area.x1 = slot.x + (ICON_WIDTH - EXTRA_BADGE_SIZE) / 2;
+        occluder.area.y1 = slot.y + (ICON_HEIGHT - EXTRA_BADGE_SIZE) / 2;
+        occluder.area.x2 = occluder.area.x1 + EXTRA_BADGE_SIZE - 1;
+        occluder.area.y2 = occluder.area.y1 + EXTRA_BADGE_SIZE - 1;
+        occluder.radius = EXTRA_BADGE_SIZE / 2;
+    }
+
+    Serial.printf("Background layer composed in %lu us (state 0x%02lX)\n",
+                  micros() - start_us, (unsigned long)state);
+}
+
+// Inside an icon's rounded rectangle; dots stay visible over the transparent corners
+static bool isOccludedByIcon(int x, int y) {
+    for (int i = 0; i < bg_occluder_count; i++) {
+        const lv_area_t &area = bg_occluders[i].area;
+        if (x < area.x1 || x > area.x2 || y < area.y1 || y > area.y2) continue;
+
+        // Distance to the nearest corner circle center (0 outside the corner squares)
+        const int r = bg_occluders[i].radius;
+        const int dx = x < area.x1 + r ? area.x1 + r - x : (x > area.x2 - r ? x - (area.x2 - r) : 0);
+        const int dy = y < area.y1 + r ? area.y1 + r - y : (y > area.y2 - r ? y - (area.y2 - r) : 0);
+        if (dx * dx + dy * dy <= r * r) return true;
+    }
+    return false;
+}
+
+// ============== Animation Rate ==============
+
+void setDashboardDimmed(bool dimmed) {
+    g_dimmed = dimmed;
+}
+
+// The main screen is loaded and no overlay (MQTT setup, WiFi error) covers it
+static bool isDashboardVisible() {
+    return main_screen && lv_scr_act() == main_screen &&
+           !isMqttConfigScreenVisible() && !isWifiErrorScreenVisible();
+}
+
+// Flow animation frame interval for the next frame
+static uint32_t animationFrameMs(float max_active) {
+    if (g_dimmed) return ANIMATION_FRAME_MS_DIMMED;
+    if (max_active < ANIMATION_SLOW_FLOW_W) return ANIMATION_FRAME_MS_SLOW;
+    return ANIMATION_FRAME_MS;
+}
+
 // ============== Data RX Pulse Animation ==============
 
 void updateDataRxPulse() {
     if (!dot_data_rx) return;
     
+    if (!isDashboardVisible()) return;
+
     const unsigned long now = millis();
     
-    // Throttle updates to ~30 FPS
-    if (now - last_pulse_update_ms < ANIMATION_FRAME_MS) {
+    // Throttle updates to ~30 FPS (10 FPS while dimmed)
+    if (now - last_pulse_update_ms < (g_dimmed ? ANIMATION_FRAME_MS_DIMMED : ANIMATION_FRAME_MS)) {
         return;
     }
     last_pulse_update_ms = now;
@@ -470,7 +669,7 @@ void updateDataRxPulse() {
     //  - AND at least 1 second has passed since the last pulse started
     if (since_data <= 200 && since_pulse >= 1000) {
         last_pulse_ms = now;
-        lv_obj_clear_flag(dot_data_rx, LV_OBJ_FLAG_HIDDEN);
+        viewSetHidden(view_data_rx, false);
     }
     
     const unsigned long pulse_age = now - last_pulse_ms;
@@ -487,16 +686,41 @@ void updateDataRxPulse() {
         // LVGL opacity range is 0-255, so scale accordingly
         lv_opa_t opacity = (lv_opa_t)((int)(a * 255.0f));
         lv_obj_set_style_bg_opa(dot_data_rx, opacity, 0);
-    } else {
-        lv_obj_add_flag(dot_data_rx, LV_OBJ_FLAG_HIDDEN);
+    } else if (!view_data_rx.hidden_valid || !view_data_rx.hidden) {
+        // Only the end of a pulse counts; idle ticks would flood ui.updates_suppressed
+        viewSetHidden(view_data_rx, true);
     }
 }
 
 // ============== Power Value Update Functions ==============
 // These will be called when MQTT data arrives
 
+static void setDashboardStale(bool stale) {
+    g_stale = stale;
+    for (lv_obj_t **label : stale_labels) {
+        if (!*label) continue;
+        if (stale) {
+            lv_obj_add_state(*label, UI_STATE_STALE);
+        } else {
+            lv_obj_clear_state(*label, UI_STATE_STALE);
+        }
+    }
+    if (lbl_stale) {
+        if (stale) {
+            lv_obj_clear_flag(lbl_stale, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(lbl_stale, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
 // Helper to hide config screen on first data
 static void onDataReceived() {
+    // Restored values are not data: no RX pulse, config screen logic unchanged
+    if (g_restoring) return;
+    if (g_stale) {
+        setDashboardStale(false);
+    }
     if (!mqtt_data_received) {
         mqtt_data_received = true;
         hideMqttConfigScreen();
@@ -513,15 +737,16 @@ void updateSolarValue(float watts) {
         // Round to 0.0 if the value is between -100 and 100
         if (watts > -100 && watts < 100) {
             kw = 0.0f;
-            lv_obj_clear_flag(img_solar_disabled, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_set_style_opa(lbl_solar_val, LV_OPA_80, 0);
+            g_solar_idle = true;
+            viewSetOpa(view_solar_val, LV_OPA_80);
         } else {
-            lv_obj_add_flag(img_solar_disabled, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_set_style_opa(lbl_solar_val, LV_OPA_COVER, 0);
+            g_solar_idle = false;
+            viewSetOpa(view_solar_val, LV_OPA_COVER);
         }
 
         snprintf(buf, sizeof(buf), "%.1f kW", kw);
-        lv_label_set_text(lbl_solar_val, buf);
+        viewSetGlyphText(view_solar_val, buf);
+        composeBackground();
     }
     onDataReceived();
 }
@@ -535,15 +760,16 @@ void updateGridValue(float watts) {
         // Round to 0.0 if the value is between -100 and 100
         if (watts > -100 && watts < 100) {
             kw = 0.0f;
-            lv_obj_clear_flag(img_grid_disabled, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_set_style_opa(lbl_grid_val, LV_OPA_80, 0);
+            g_grid_idle = true;
+            viewSetOpa(view_grid_val, LV_OPA_80);
         } else {
-            lv_obj_add_flag(img_grid_disabled, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_set_style_opa(lbl_grid_val, LV_OPA_COVER, 0);
+            g_grid_idle = false;
+            viewSetOpa(view_grid_val, LV_OPA_COVER);
         }
 
         snprintf(buf, sizeof(buf), "%.1f kW", kw);
-        lv_label_set_text(lbl_grid_val, buf);
+        viewSetGlyphText(view_grid_val, buf);
+        composeBackground();
     }
     onDataReceived();
 }
@@ -560,7 +786,7 @@ void updateHomeValue(float watts) {
         }
 
         snprintf(buf, sizeof(buf), "%.1f kW", kw);
-        lv_label_set_text(lbl_home_val, buf);
+        viewSetGlyphText(view_home_val, buf);
     }
     onDataReceived();
 }
@@ -574,15 +800,16 @@ void updateBatteryValue(float watts) {
         // Round to 0.0 if the value is between -100 and 100
         if (watts > -100 && watts < 100) {
             kw = 0.0f;
-            lv_obj_clear_flag(img_battery_disabled, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_set_style_opa(lbl_batt_val, LV_OPA_80, 0);
+            g_batt_idle = true;
+            viewSetOpa(view_batt_val, LV_OPA_80);
         } else {
-            lv_obj_add_flag(img_battery_disabled, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_set_style_opa(lbl_batt_val, LV_OPA_COVER, 0);
+            g_batt_idle = false;
+            viewSetOpa(view_batt_val, LV_OPA_COVER);
         }
 
         snprintf(buf, sizeof(buf), "%.1f kW", kw);
-        lv_label_set_text(lbl_batt_val, buf);
+        viewSetGlyphText(view_batt_val, buf);
+        composeBackground();
     }
     onDataReceived();
 }
@@ -597,14 +824,14 @@ void updateSOC(float soc_percent) {
     if (lbl_soc) {
         char buf[16];
         snprintf(buf, sizeof(buf), "%d%%", (int)roundf(adjusted));
-        lv_label_set_text(lbl_soc, buf);
+        viewSetGlyphText(view_soc, buf);
     }
 
     // Update off-grid label with same value but with gray % symbol
     if (lbl_soc_offgrid) {
         char buf[BUFFER_SIZE_SMALL];
-        snprintf(buf, sizeof(buf), "%d#%06X %%#", (int)roundf(adjusted), COLOR_GRAY);
-        lv_label_set_text(lbl_soc_offgrid, buf);
+        snprintf(buf, sizeof(buf), "%d", (int)roundf(adjusted));
+        viewSetGlyphText(view_soc_offgrid, buf, "%");
     }
 
     if (bar_soc) {
@@ -619,45 +846,41 @@ void updateOffGridStatus(int offgrid) {
     
     if (g_offgrid) {
         // Show off-grid UI elements
-        if (img_grid_offline) {
-            lv_obj_clear_flag(img_grid_offline, LV_OBJ_FLAG_HIDDEN);
-        }
         if (lbl_soc_offgrid) {
-            lv_obj_clear_flag(lbl_soc_offgrid, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_soc_offgrid, false);
         }
         // Show time remaining only if we have a valid value
         if (lbl_time_remaining && g_time_remaining > 0) {
-            lv_obj_clear_flag(lbl_time_remaining, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_time_remaining, false);
         }
         
         // Hide normal grid label and SOC label
         if (lbl_soc) {
-            lv_obj_add_flag(lbl_soc, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_soc, true);
         }
         if (lbl_grid_val) {
-            lv_obj_add_flag(lbl_grid_val, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_grid_val, true);
         }
     } else {
         // Hide off-grid UI elements
-        if (img_grid_offline) {
-            lv_obj_add_flag(img_grid_offline, LV_OBJ_FLAG_HIDDEN);
-        }
         if (lbl_soc_offgrid) {
-            lv_obj_add_flag(lbl_soc_offgrid, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_soc_offgrid, true);
         }
         if (lbl_time_remaining) {
-            lv_obj_add_flag(lbl_time_remaining, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_time_remaining, true);
         }
         
         // Show normal grid label and SOC label
         if (lbl_soc) {
-            lv_obj_clear_flag(lbl_soc, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_soc, false);
         }
         if (lbl_grid_val) {
-            lv_obj_clear_flag(lbl_grid_val, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_grid_val, false);
         }
     }
-    
+
+    composeBackground();
+
     Serial.printf("Off-grid status: %d\n", offgrid);
     onDataReceived();
 }
@@ -668,17 +891,17 @@ void updateTimeRemaining(float hours) {
     if (lbl_time_remaining) {
         if (hours > 0) {
             char buf[BUFFER_SIZE_MEDIUM];
-            // Format: "12.5 #6A6A6A hours#" (hours in gray)
-            snprintf(buf, sizeof(buf), "%.1f #%06X hours#", hours, COLOR_GRAY);
-            lv_label_set_text(lbl_time_remaining, buf);
+            // Format: "12.5 hours" (hours in gray)
+            snprintf(buf, sizeof(buf), "%.1f", hours);
+            viewSetGlyphText(view_time_remaining, buf, " hours");
             
             // Only show if we're off-grid
             if (g_offgrid) {
-                lv_obj_clear_flag(lbl_time_remaining, LV_OBJ_FLAG_HIDDEN);
+                viewSetHidden(view_time_remaining, false);
             }
         } else {
             // Hide if no time remaining data
-            lv_obj_add_flag(lbl_time_remaining, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_time_remaining, true);
         }
     }
     
@@ -691,50 +914,20 @@ void updateTimeRemaining(float hours) {
 void setEVEnabled(bool enabled) {
     g_ev_enabled = enabled;
 
+    // Positions come from the layout variant; visibility follows the EV state
+    applyDashboardLayout(enabled ? DASH_LAYOUT_EV : DASH_LAYOUT_DEFAULT);
     if (enabled) {
-        // Reposition Home icon and label for EV-enabled layout
-        if (img_home) lv_obj_set_pos(img_home, HOME_ICON_X_EV, HOME_ICON_Y_EV);
-        if (lbl_home_val) lv_obj_set_pos(lbl_home_val, HOME_VAL_X_EV, HOME_VAL_Y_EV);
-
-        // Position EV icon and labels for EV-enabled layout
-        if (img_ev) {
-            lv_obj_set_pos(img_ev, EV_ICON_X_EV, EV_ICON_Y_EV);
-            lv_obj_clear_flag(img_ev, LV_OBJ_FLAG_HIDDEN);
-        }
-        if (img_ev_disabled) lv_obj_set_pos(img_ev_disabled, EV_ICON_X_EV, EV_ICON_Y_EV);
-        if (lbl_ev_val) {
-            lv_obj_set_pos(lbl_ev_val, EV_VAL_X_EV, EV_VAL_Y_EV);
-            lv_obj_clear_flag(lbl_ev_val, LV_OBJ_FLAG_HIDDEN);
-        }
-        if (lbl_ev_soc) lv_obj_set_pos(lbl_ev_soc, EV_VAL_X_EV, EV_VAL_Y_EV + LABEL_HEIGHT);
-
-        // Update animation center positions for EV-enabled layout
-        g_home_center_x = HOME_ICON_X_EV + ICON_WIDTH / 2;
-        g_home_center_y = HOME_ICON_Y_EV + ICON_HEIGHT / 2;
-        g_ev_center_x = EV_ICON_X_EV + ICON_WIDTH / 2;
-        g_ev_center_y = EV_ICON_Y_EV + ICON_HEIGHT / 2;
+        viewSetHidden(view_ev_val, false);
     } else {
-        // Restore Home icon and label to default positions
-        if (img_home) lv_obj_set_pos(img_home, HOME_ICON_X, HOME_ICON_Y);
-        if (lbl_home_val) lv_obj_set_pos(lbl_home_val, HOME_VAL_X, HOME_VAL_Y);
-
-        // Hide all EV elements
-        if (img_ev) lv_obj_add_flag(img_ev, LV_OBJ_FLAG_HIDDEN);
-        if (img_ev_disabled) lv_obj_add_flag(img_ev_disabled, LV_OBJ_FLAG_HIDDEN);
-        if (lbl_ev_val) lv_obj_add_flag(lbl_ev_val, LV_OBJ_FLAG_HIDDEN);
-        if (lbl_ev_soc) lv_obj_add_flag(lbl_ev_soc, LV_OBJ_FLAG_HIDDEN);
-
-        // Hide animation dots
-        if (dot_home_ev) lv_obj_add_flag(dot_home_ev, LV_OBJ_FLAG_HIDDEN);
-        if (dot_home_ev_2) lv_obj_add_flag(dot_home_ev_2, LV_OBJ_FLAG_HIDDEN);
-        if (dot_home_ev_3) lv_obj_add_flag(dot_home_ev_3, LV_OBJ_FLAG_HIDDEN);
-
-        // Restore animation center positions to defaults
-        g_home_center_x = HOME_ICON_X + ICON_WIDTH / 2;
-        g_home_center_y = HOME_ICON_Y + ICON_HEIGHT / 2;
-        g_ev_center_x = EV_ICON_X + ICON_WIDTH / 2;
-        g_ev_center_y = EV_ICON_Y + ICON_HEIGHT / 2;
+        viewSetHidden(view_ev_val, true);
+        viewSetHidden(view_ev_soc, true);
     }
+
+    // The EV node joins or leaves the flow topology
+    rebuildFlowTopology();
+
+    // Bake the new icon layout into the background layer
+    composeBackground();
 }
 
 void updateEVValue(float watts) {
@@ -749,15 +942,16 @@ void updateEVValue(float watts) {
         // Show disabled state if power is near zero
         if (watts > -100 && watts < 100) {
             kw = 0.0f;
-            if (img_ev_disabled) lv_obj_clear_flag(img_ev_disabled, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_set_style_opa(lbl_ev_val, LV_OPA_80, 0);
+            g_ev_idle = true;
+            viewSetOpa(view_ev_val, LV_OPA_80);
         } else {
-            if (img_ev_disabled) lv_obj_add_flag(img_ev_disabled, LV_OBJ_FLAG_HIDDEN);
-            lv_obj_set_style_opa(lbl_ev_val, LV_OPA_COVER, 0);
+            g_ev_idle = false;
+            viewSetOpa(view_ev_val, LV_OPA_COVER);
         }
 
         snprintf(buf, sizeof(buf), "%.1f kW", kw);
-        lv_label_set_text(lbl_ev_val, buf);
+        viewSetGlyphText(view_ev_val, buf);
+        composeBackground();
     }
 
     Serial.printf("EV Power: %.1f W\n", watts);
@@ -770,13 +964,8 @@ void updateEVConnected(bool connected) {
     if (!g_ev_enabled) return;
 
     // When connected, show normal icon; when not connected, dim the icon
-    if (img_ev) {
-        if (connected) {
-            lv_obj_set_style_opa(img_ev, LV_OPA_COVER, 0);
-        } else {
-            lv_obj_set_style_opa(img_ev, LV_OPA_50, 0);
-        }
-    }
+    g_ev_dimmed = !connected;
+    composeBackground();
 
     Serial.printf("EV Connected: %s\n", connected ? "yes" : "no");
 }
@@ -790,16 +979,117 @@ void updateEVSOC(float percent) {
         if (percent > 0) {
             char buf[BUFFER_SIZE_SMALL];
             snprintf(buf, sizeof(buf), "%.0f%%", percent);
-            lv_label_set_text(lbl_ev_soc, buf);
-            lv_obj_clear_flag(lbl_ev_soc, LV_OBJ_FLAG_HIDDEN);
+            viewSetLabelText(view_ev_soc, buf);
+            viewSetHidden(view_ev_soc, false);
         } else {
-            lv_obj_add_flag(lbl_ev_soc, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(view_ev_soc, true);
         }
     }
 
     Serial.printf("EV SOC: %.1f%%\n", percent);
 }
 
+// ============== Extra Flow Nodes ==============
+
+static const char* extraNodeBadgeText(PowerNodeRole role) {
+    switch (role) {
+        case NODE_GENERATOR: return "GEN";
+        case NODE_BATTERY:   return "BAT";
+        case NODE_EV:        return "EV";
+        default:             return "";
+    }
+}
+
+static lv_style_t* extraNodeBadgeStyle(PowerNodeRole role) {
+    switch (role) {
+        case NODE_GENERATOR: return &ui_style_badge_generator;
+        case NODE_BATTERY:   return &ui_style_badge_battery;
+        default:             return &ui_style_badge_ev;
+    }
+}
+
+// Show the configured badges and value labels, hide the unused slots
+static void applyExtraNodeWidgets() {
+    for (uint8_t i = 0; i < MQTT_MAX_EXTRA_NODES; i++) {
+        ExtraNodeView &extra = g_extra_nodes[i];
+        if (!extra.badge) continue;
+
+        if (i < g_extra_count) {
+            lv_label_set_text_static(extra.badge_label, extraNodeBadgeText(extra.role));
+            lv_style_t *style = extraNodeBadgeStyle(extra.role);
+            if (extra.badge_style != style) {
+                if (extra.badge_style) lv_obj_remove_style(extra.badge, extra.badge_style, 0);
+                lv_obj_add_style(extra.badge, style, 0);
+                extra.badge_style = style;
+            }
+            lv_obj_clear_flag(extra.badge, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(extra.view_value, false);
+        } else {
+            lv_obj_add_flag(extra.badge, LV_OBJ_FLAG_HIDDEN);
+            viewSetHidden(extra.view_value, true);
+        }
+    }
+}
+
+void configureExtraNodes(const PowerNodeRole *roles, uint8_t count) {
+    if (count > MQTT_MAX_EXTRA_NODES) count = MQTT_MAX_EXTRA_NODES;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (g_extra_nodes[i].role != roles[i]) g_extra_nodes[i].w = 0.0f;
+        g_extra_nodes[i].role = roles[i];
+    }
+    g_extra_count = count;
+
+    applyExtraNodeWidgets();
+    rebuildFlowTopology();
+
+    // Badge areas are occluders, recompose even if no icon state changed
+    bg_state = BG_STATE_NONE;
+    composeBackground();
+}
+
+void updateExtraNodeValue(uint8_t index, float watts) {
+    if (index >= g_extra_count) return;
+    ExtraNodeView &extra = g_extra_nodes[index];
+    extra.w = watts;
+
+    if (extra.value_label) {
+        char buf[BUFFER_SIZE_SMALL];
+        float kw = watts / 1000.0f;
+
+        if (watts > -100 && watts < 100) {
+            kw = 0.0f;
+            viewSetOpa(extra.view_value, LV_OPA_80);
+        } else {
+            viewSetOpa(extra.view_value, LV_OPA_COVER);
+        }
+
+        snprintf(buf, sizeof(buf), "%.1f kW", kw);
+        viewSetGlyphText(extra.view_value, buf);
+    }
+    onDataReceived();
+}
+
+// ============== Restored Values ==============
+
+void applyRestoredMetrics(const StoredMetrics &metrics) {
+    g_restoring = true;
+
+    if (hasMetric(metrics, METRIC_SOLAR)) updateSolarValue(metrics.values[METRIC_SOLAR]);
+    if (hasMetric(metrics, METRIC_GRID)) updateGridValue(metrics.values[METRIC_GRID]);
+    if (hasMetric(metrics, METRIC_HOME)) updateHomeValue(metrics.values[METRIC_HOME]);
+    if (hasMetric(metrics, METRIC_BATTERY)) updateBatteryValue(metrics.values[METRIC_BATTERY]);
+    if (hasMetric(metrics, METRIC_SOC)) updateSOC(metrics.values[METRIC_SOC]);
+    if (hasMetric(metrics, METRIC_TIME_REMAINING)) updateTimeRemaining(metrics.values[METRIC_TIME_REMAINING]);
+    if (hasMetric(metrics, METRIC_OFFGRID)) updateOffGridStatus((int)metrics.values[METRIC_OFFGRID]);
+    if (hasMetric(metrics, METRIC_EV)) updateEVValue(metrics.values[METRIC_EV]);
+    if (hasMetric(metrics, METRIC_EV_CONNECTED)) updateEVConnected(metrics.values[METRIC_EV_CONNECTED] != 0.0f);
+    if (hasMetric(metrics, METRIC_EV_SOC)) updateEVSOC(metrics.values[METRIC_EV_SOC]);
+
+    g_restoring = false;
+    setDashboardStale(true);
+}
+
 // ============== Power Flow Dot Animation ==============
 
 // Helper functions for animation (defined once, outside the main animation function)
@@ -813,18 +1103,82 @@ namespace {
     }
 }
 
+// Node list for the flow solver: the four fixed icons, the EV icon when
+// enabled, then the extra nodes, at the current layout's icon centers.
+// Values are copied in every frame.
+static void rebuildFlowTopology() {
+    g_topology.count = 0;
+
+    auto add = [](PowerNodeRole role, DashIcon icon, uint8_t feeder) -> uint8_t {
+        const uint8_t index = addPowerNode(g_topology, role, feeder);
+        if (index != POWER_NODE_NONE) g_node_centers[index] = iconCenter(icon);
+        return index;
+    };
+
+    g_node_solar = add(NODE_SOLAR, DASH_ICON_SOLAR, POWER_NODE_NONE);
+    g_node_grid = add(NODE_GRID, DASH_ICON_GRID, POWER_NODE_NONE);
+    g_node_home = add(NODE_HOME, DASH_ICON_HOME, POWER_NODE_NONE);
+    g_node_battery = add(NODE_BATTERY, DASH_ICON_BATTERY, POWER_NODE_NONE);
+    g_node_ev = g_ev_enabled ? add(NODE_EV, DASH_ICON_EV, g_node_home) : POWER_NODE_NONE;
+
+    for (uint8_t i = 0; i < g_extra_count; i++) {
+        ExtraNodeView &extra = g_extra_nodes[i];
+        extra.node = add(extra.role, (DashIcon)(DASH_ICON_EXTRA_1 + i),
+                         extra.role == NODE_EV ? g_node_home : POWER_NODE_NONE);
+    }
+}
+
+static void syncFlowTopology() {
+    PowerNode *nodes = g_topology.nodes;
+    nodes[g_node_solar].w = g_solar_w;
+    nodes[g_node_grid].w = g_grid_w;
+    nodes[g_node_home].w = g_home_w;
+    nodes[g_node_battery].w = g_batt_w;
+    nodes[g_node_battery].soc = g_soc;
+    if (g_node_ev != POWER_NODE_NONE) nodes[g_node_ev].w = g_ev_w;
+    for (uint8_t i = 0; i < g_extra_count; i++) {
+        if (g_extra_nodes[i].node != POWER_NODE_NONE) nodes[g_extra_nodes[i].node].w = g_extra_nodes[i].w;
+    }
+}
+
+// Dot color of a flow: EV charging is always cyan, otherwise the source's color
+static lv_style_t* flowDotStyle(PowerNodeRole from, PowerNodeRole to) {
+    if (to == NODE_EV) return &ui_style_dot_ev;
+    switch (from) {
+        case NODE_GENERATOR: return &ui_style_dot_generator;
+        case NODE_GRID:      return &ui_style_dot_grid;
+        case NODE_BATTERY:   return &ui_style_dot_battery;
+        default:             return &ui_style_dot_solar;
+    }
+}
+
+static void hideFlowDots(uint8_t from) {
+    for (uint8_t i = from; i < flow_dots_used; i++) {
+        lv_obj_add_flag(flow_dots[i], LV_OBJ_FLAG_HIDDEN);
+    }
+    flow_dots_used = from;
+}
+
 void updatePowerFlowAnimation() {
-    // Geometry - icon center positions
-    // Static positions use compile-time constants
-    const int SX = SOLAR_CENTER_X, SY = SOLAR_CENTER_Y;     // Solar
-    const int BX = BATTERY_CENTER_X, BY = BATTERY_CENTER_Y; // Battery
-    const int GX = GRID_CENTER_X, GY = GRID_CENTER_Y;       // Grid
-    const int CX = CENTER_X, CY = CENTER_Y;                 // Center
-    // Dynamic positions use runtime variables (updated by setEVEnabled)
-    const int HX = g_home_center_x, HY = g_home_center_y;   // Home
-    const int EVX = g_ev_center_x, EVY = g_ev_center_y;     // EV
-
-    const float THRESH_W = 50.0f;
+    if (!flow_dots[0] || g_topology.count == 0) return;
+
+    // Nothing to animate while another screen or overlay covers the dashboard
+    if (!isDashboardVisible()) {
+        g_last_anim_ms = 0;
+        return;
+    }
+
+    // Throttle to the interval picked by the last frame, before solving
+    const unsigned long now = millis();
+    const unsigned long last_anim = g_last_anim_ms;
+    if (last_anim != 0 && now >= last_anim && now - last_anim < g_anim_frame_ms) {
+        return;
+    }
+
+    // Geometry - center icon position (node positions come from the topology)
+    const lv_point_t center = iconCenter(DASH_ICON_CENTER);
+    const int CX = center.x, CY = center.y;
+
     const float FADE = 0.12f;
     const int DOT_R = 6;
     
@@ -837,9 +1191,6 @@ void updatePowerFlowAnimation() {
     const float OPACITY_SCALE = 200.0f;     // Scale factor for opacity calculation
     const float OPACITY_FLOOR = 10.0f;      // Minimum opacity value
     
-    // Battery state of charge threshold
-    const float BATTERY_FULL_THRESHOLD = 99.5f;  // Consider battery full at this SOC
-    
     // Inline helper for setting dot position
     auto set_dot_pos = [DOT_R](lv_obj_t* dot, int x, int y) {
         lv_obj_set_pos(dot, x - DOT_R, y - DOT_R);
@@ -853,23 +1204,18 @@ void updatePowerFlowAnimation() {
         lv_obj_set_style_bg_opa(dot, (lv_opa_t)lroundf(opa_float), 0);
     };
 
-    
-    // Place dot on two-segment path and animate
-    auto animate_dot = [&](lv_obj_t* dot, float t, float watts,
+    // Place dot on its path: through the center icon, or direct for the
+    // short hop to an EV charger
+    auto animate_dot = [&](lv_obj_t* dot, float t, bool direct,
                            int x_src, int y_src, int x_sink, int y_sink) {
-        if (watts < THRESH_W) {
-            lv_obj_add_flag(dot, LV_OBJ_FLAG_HIDDEN);
-            return;
-        }
-        
-        lv_obj_clear_flag(dot, LV_OBJ_FLAG_HIDDEN);
-        
         // Clamp t to [0, 1]
         t = clampf(t, 0.0f, 1.0f);
         
-        // Calculate position on two-segment path
         int x, y;
-        if (t < 0.5f) {
+        if (direct) {
+            x = lerp_i(x_src, x_sink, t);
+            y = lerp_i(y_src, y_sink, t);
+        } else if (t < 0.5f) {
             // First segment: source → center
             float seg_t = t * 2.0f;
             x = lerp_i(x_src, CX, seg_t);
@@ -881,6 +1227,13 @@ void updatePowerFlowAnimation() {
             y = lerp_i(CY, y_sink, seg_t);
         }
         
+        // Dots pass underneath the icons baked into the background layer
+        if (isOccludedByIcon(x, y)) {
+            lv_obj_add_flag(dot, LV_OBJ_FLAG_HIDDEN);
+            return;
+        }
+
+        lv_obj_clear_flag(dot, LV_OBJ_FLAG_HIDDEN);
         set_dot_pos(dot, x, y);
         
         // Calculate fade alpha
@@ -893,209 +1246,61 @@ void updatePowerFlowAnimation() {
         set_dot_opa(dot, alpha);
     };
 
-    // Read instantaneous powers
-    const float grid_w = g_grid_w;
-    const float home_w = g_home_w;
-    const float solar_w = g_solar_w;
-    const float batt_w = g_batt_w;
-    const float soc = g_soc;
-
-    float solar_src = solar_w > 0 ? solar_w : 0;
-    float grid_src = grid_w > 0 ? grid_w : 0;
-    float batt_src = batt_w > 0 ? batt_w : 0;
-
-    float home_sink = home_w > 0 ? home_w : 0;
-    float batt_sink = batt_w < 0 ? -batt_w : 0;
-    float grid_sink = grid_w < 0 ? -grid_w : 0;
-
-    // Flow allocation (visual only)
-    float f_s2h = 0, f_s2b = 0, f_s2g = 0;
-    float f_g2h = 0, f_g2b = 0;
-    float f_b2h = 0, f_b2g = 0;
-    float f_h2ev = 0;  // Home to EV flow
-
-    float rem_solar = solar_src;
-    float rem_home = home_sink;
-    float rem_batt = batt_sink;
-    float rem_grid = grid_sink;
-
-    // Priority: solar to battery first (if not full)
-    if (rem_solar > 0 && rem_batt > 0 && soc < BATTERY_FULL_THRESHOLD) {
-        f_s2b = fminf(rem_solar, rem_batt);
-        rem_solar -= f_s2b;
-        rem_batt -= f_s2b;
-    }
-
-    // Solar to home
-    if (rem_solar > 0 && rem_home > 0) {
-        f_s2h = fminf(rem_solar, rem_home);
-        rem_solar -= f_s2h;
-        rem_home -= f_s2h;
-    }
-
-    // Solar to grid (export)
-    if (rem_solar > 0 && rem_grid > 0) {
-        f_s2g = fminf(rem_solar, rem_grid);
-        rem_solar -= f_s2g;
-        rem_grid -= f_s2g;
-    }
-
-    // Grid to battery
-    float rem_grid_src = grid_src;
-    if (rem_grid_src > 0 && rem_batt > 0) {
-        f_g2b = fminf(rem_grid_src, rem_batt);
-        rem_grid_src -= f_g2b;
-        rem_batt -= f_g2b;
-    }
-
-    // Grid to home
-    if (rem_grid_src > 0 && rem_home > 0) {
-        f_g2h = fminf(rem_grid_src, rem_home);
-        rem_grid_src -= f_g2h;
-        rem_home -= f_g2h;
-    }
-
-    // Battery to home
-    float rem_batt_src = batt_src;
-    if (rem_batt_src > 0 && rem_home > 0) {
-        f_b2h = fminf(rem_batt_src, rem_home);
-        rem_batt_src -= f_b2h;
-        rem_home -= f_b2h;
-    }
-
-    // Battery to grid (export)
-    if (rem_batt_src > 0 && rem_grid > 0) {
-        f_b2g = fminf(rem_batt_src, rem_grid);
-        rem_batt_src -= f_b2g;
-        rem_grid -= f_b2g;
-    }
-
-    // Home to EV (EV charging power, if EV is enabled)
-    if (g_ev_enabled && g_ev_w > THRESH_W) {
-        f_h2ev = g_ev_w;
-    }
-
-    // Find max active flow
-    float max_active = 0.0f;
-    auto consider = [&](float w) {
-        if (w >= THRESH_W && w > max_active) max_active = w;
-    };
-
-    consider(f_s2h); consider(f_s2b); consider(f_s2g);
-    consider(f_g2h); consider(f_g2b);
-    consider(f_b2h); consider(f_b2g);
-    consider(f_h2ev);  // EV flow
+    syncFlowTopology();
+    PowerFlowResult flows;
+    solvePowerFlows(g_topology, flows);
 
     // If no active flows, hide all dots
-    if (max_active < THRESH_W) {
-        lv_obj_t* all_dots[] = {
-            dot_solar_home, dot_solar_home_2, dot_solar_home_3,
-            dot_solar_batt, dot_solar_batt_2, dot_solar_batt_3,
-            dot_solar_grid, dot_solar_grid_2, dot_solar_grid_3,
-            dot_grid_home, dot_grid_home_2, dot_grid_home_3,
-            dot_grid_batt, dot_grid_batt_2, dot_grid_batt_3,
-            dot_batt_home, dot_batt_home_2, dot_batt_home_3,
-            dot_batt_grid, dot_batt_grid_2, dot_batt_grid_3,
-            dot_home_ev, dot_home_ev_2, dot_home_ev_3  // EV dots
-        };
-        for (auto dot : all_dots) {
-            lv_obj_add_flag(dot, LV_OBJ_FLAG_HIDDEN);
-        }
-        g_last_anim_ms = 0;  // Reset animation time
+    if (flows.max_active == 0.0f) {
+        hideFlowDots(0);
+        g_last_anim_ms = now;
+        g_anim_frame_ms = ANIMATION_FRAME_MS_IDLE;
         return;
     }
 
-    // Calculate elapsed time and throttle updates to ~30 FPS
-    const unsigned long now = millis();
-    const unsigned long last_anim = g_last_anim_ms;
-    unsigned long elapsed_ms;
-    
-    if (last_anim == 0 || now < last_anim) {
-        elapsed_ms = ANIMATION_FRAME_MS;
-    } else {
-        elapsed_ms = now - last_anim;
-    }
-    
-    // Throttle to ~30 FPS
-    if (elapsed_ms < ANIMATION_FRAME_MS && last_anim != 0) {
-        return;  // Skip this update, not enough time has passed
-    }
-    
+    // Elapsed time since the last frame (nominal after a pause)
+    const unsigned long elapsed_ms = (last_anim == 0 || now < last_anim) ? ANIMATION_FRAME_MS : now - last_anim;
     const float dt_seconds = (float)elapsed_ms / 1000.0f;
     g_last_anim_ms = now;
+    g_anim_frame_ms = animationFrameMs(flows.max_active);
 
     // Advance master phase
-    float speed = clampf(max_active / SPEED_DIVISOR, MIN_SPEED, MAX_SPEED);
+    float speed = clampf(flows.max_active / SPEED_DIVISOR, MIN_SPEED, MAX_SPEED);
     ph_master += speed * dt_seconds;
     if (ph_master >= 1.0f) ph_master -= floorf(ph_master);
 
     // Calculate phases for 3 dots evenly spaced (no easing needed for linear)
-    const float phase_1 = ph_master;
-    const float phase_2 = fmodf(ph_master + 0.33333f, 1.0f);
-    const float phase_3 = fmodf(ph_master + 0.66667f, 1.0f);
-
-    // Animate all flows
-    // Solar flows (yellow dots)
-    animate_dot(dot_solar_home, phase_1, f_s2h, SX, SY, HX, HY);
-    animate_dot(dot_solar_home_2, phase_2, f_s2h, SX, SY, HX, HY);
-    animate_dot(dot_solar_home_3, phase_3, f_s2h, SX, SY, HX, HY);
-    
-    animate_dot(dot_solar_batt, phase_1, f_s2b, SX, SY, BX, BY);
-    animate_dot(dot_solar_batt_2, phase_2, f_s2b, SX, SY, BX, BY);
-    animate_dot(dot_solar_batt_3, phase_3, f_s2b, SX, SY, BX, BY);
-    
-    animate_dot(dot_solar_grid, phase_1, f_s2g, SX, SY, GX, GY);
-    animate_dot(dot_solar_grid_2, phase_2, f_s2g, SX, SY, GX, GY);
-    animate_dot(dot_solar_grid_3, phase_3, f_s2g, SX, SY, GX, GY);
-
-    // Grid flows (gray dots)
-    animate_dot(dot_grid_home, phase_1, f_g2h, GX, GY, HX, HY);
-    animate_dot(dot_grid_home_2, phase_2, f_g2h, GX, GY, HX, HY);
-    animate_dot(dot_grid_home_3, phase_3, f_g2h, GX, GY, HX, HY);
-    
-    animate_dot(dot_grid_batt, phase_1, f_g2b, GX, GY, BX, BY);
-    animate_dot(dot_grid_batt_2, phase_2, f_g2b, GX, GY, BX, BY);
-    animate_dot(dot_grid_batt_3, phase_3, f_g2b, GX, GY, BX, BY);
-
-    // Battery flows (green dots)
-    animate_dot(dot_batt_home, phase_1, f_b2h, BX, BY, HX, HY);
-    animate_dot(dot_batt_home_2, phase_2, f_b2h, BX, BY, HX, HY);
-    animate_dot(dot_batt_home_3, phase_3, f_b2h, BX, BY, HX, HY);
-    
-    animate_dot(dot_batt_grid, phase_1, f_b2g, BX, BY, GX, GY);
-    animate_dot(dot_batt_grid_2, phase_2, f_b2g, BX, BY, GX, GY);
-    animate_dot(dot_batt_grid_3, phase_3, f_b2g, BX, BY, GX, GY);
-
-    // EV flows (cyan dots) - direct path from Home to EV (not through center)
-    // Use a simpler direct linear animation for this short path
-    auto animate_dot_direct = [&](lv_obj_t* dot, float t, float watts,
-                                   int x_src, int y_src, int x_dst, int y_dst) {
-        if (watts < THRESH_W) {
-            lv_obj_add_flag(dot, LV_OBJ_FLAG_HIDDEN);
-            return;
-        }
-
-        lv_obj_clear_flag(dot, LV_OBJ_FLAG_HIDDEN);
-        t = clampf(t, 0.0f, 1.0f);
-
-        // Direct linear interpolation
-        int x = lerp_i(x_src, x_dst, t);
-        int y = lerp_i(y_src, y_dst, t);
-        set_dot_pos(dot, x, y);
+    const float phases[FLOW_DOTS_PER_EDGE] = {
+        ph_master,
+        fmodf(ph_master + 0.33333f, 1.0f),
+        fmodf(ph_master + 0.66667f, 1.0f),
+    };
 
-        // Fade in/out at ends
-        float alpha = 1.0f;
-        if (t < FADE) {
-            alpha = t / FADE;
-        } else if (t > (1.0f - FADE)) {
-            alpha = (1.0f - t) / FADE;
+    // Hand out dots to the active edges (beyond FLOW_DOT_EDGES are not drawn)
+    uint8_t used = 0;
+    for (uint8_t e = 0; e < flows.count && used + FLOW_DOTS_PER_EDGE <= FLOW_DOT_COUNT; e++) {
+        const PowerFlow &flow = flows.flows[e];
+        if (!isPowerFlowActive(flow.w)) continue;
+
+        const PowerNodeRole to_role = g_topology.nodes[flow.to].role;
+        lv_style_t *style = flowDotStyle(g_topology.nodes[flow.from].role, to_role);
+        const lv_point_t &src = g_node_centers[flow.from];
+        const lv_point_t &sink = g_node_centers[flow.to];
+
+        for (uint8_t d = 0; d < FLOW_DOTS_PER_EDGE; d++, used++) {
+            lv_obj_t *dot = flow_dots[used];
+            if (flow_dot_styles[used] != style) {
+                lv_obj_remove_style(dot, flow_dot_styles[used], 0);
+                lv_obj_add_style(dot, style, 0);
+                flow_dot_styles[used] = style;
+            }
+            animate_dot(dot, phases[d], to_role == NODE_EV, src.x, src.y, sink.x, sink.y);
         }
-        set_dot_opa(dot, alpha);
-    };
+    }
 
-    if (g_ev_enabled) {
-        animate_dot_direct(dot_home_ev, phase_1, f_h2ev, HX, HY, EVX, EVY);
-        animate_dot_direct(dot_home_ev_2, phase_2, f_h2ev, HX, HY, EVX, EVY);
-        animate_dot_direct(dot_home_ev_3, phase_3, f_h2ev, HX, HY, EVX, EVY);
+    // Dots left over from a frame with more edges
+    if (used < flow_dots_used) {
+        hideFlowDots(used);
     }
+    flow_dots_used = used;
 }
@@ -0,0 +1,100 @@
+#include "metrics_store.h"
+#include <Preferences.h>
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include <time.h>
+
+#define METRICS_RTC_MAGIC 0x4D455452  // "METR"
+#define METRICS_NVS_NAMESPACE "metrics"
+#define METRICS_NVS_KEY "last"
+
+// Anything earlier means the clock has not been set by NTP
+#define METRICS_MIN_VALID_EPOCH 1600000000
+
+struct RtcMetrics {
+    uint32_t magic;
+    StoredMetrics data;
+    uint32_t crc;
+};
+
+// Not cleared on software reset, watchdog or panic
+RTC_NOINIT_ATTR static RtcMetrics rtc_metrics;
+
+static StoredMetrics current_metrics = {};
+static bool nvs_dirty = false;
+static unsigned long first_dirty_ms = 0;
+static unsigned long last_nvs_write_ms = 0;
+static const char *restore_source = "none";
+
+static uint32_t metricsCrc(const StoredMetrics &data) {
+    return esp_rom_crc32_le(0, (const uint8_t *)&data, sizeof(data));
+}
+
+static bool rtcMetricsValid() {
+    return rtc_metrics.magic == METRICS_RTC_MAGIC &&
+           rtc_metrics.crc == metricsCrc(rtc_metrics.data);
+}
+
+void recordMetric(MetricId id, float value) {
+    if (id >= METRIC_COUNT) return;
+
+    const time_t now = time(nullptr);
+    current_metrics.values[id] = value;
+    current_metrics.valid_mask |= (1U << id);
+    current_metrics.saved_epoch = now >= METRICS_MIN_VALID_EPOCH ? (uint32_t)now : 0;
+
+    rtc_metrics.magic = METRICS_RTC_MAGIC;
+    rtc_metrics.data = current_metrics;
+    rtc_metrics.crc = metricsCrc(current_metrics);
+
+    if (!nvs_dirty) {
+        nvs_dirty = true;
+        first_dirty_ms = millis();
+    }
+}
+
+bool loadStoredMetrics(StoredMetrics &out) {
+    if (rtcMetricsValid() && rtc_metrics.data.valid_mask != 0) {
+        current_metrics = rtc_metrics.data;
+        restore_source = "rtc";
+    } else {
+        Preferences preferences;
+        preferences.begin(METRICS_NVS_NAMESPACE, true);
+        const size_t len = preferences.getBytes(METRICS_NVS_KEY, &current_metrics, sizeof(current_metrics));
+        preferences.end();
+
+        if (len != sizeof(current_metrics) || current_metrics.valid_mask == 0) {
+            current_metrics = {};
+            restore_source = "none";
+            return false;
+        }
+        restore_source = "nvs";
+    }
+
+    out = current_metrics;
+    Serial.printf("Restored last metrics from %s (mask 0x%03X, epoch %lu)\n",
+                  restore_source, current_metrics.valid_mask,
+                  (unsigned long)current_metrics.saved_epoch);
+    return true;
+}
+
+void loopMetricsStore() {
+    if (!nvs_dirty) return;
+
+    const unsigned long now = millis();
+    const unsigned long due = last_nvs_write_ms == 0 ? METRICS_NVS_FIRST_DELAY_MS : METRICS_NVS_INTERVAL_MS;
+    const unsigned long since = last_nvs_write_ms == 0 ? now - first_dirty_ms : now - last_nvs_write_ms;
+    if (since < due) return;
+
+    Preferences preferences;
+    preferences.begin(METRICS_NVS_NAMESPACE, false);
+    preferences.putBytes(METRICS_NVS_KEY, &current_metrics, sizeof(current_metrics));
+    preferences.end();
+
+    nvs_dirty = false;
+    last_nvs_write_ms = now;
+}
+
+const char* getMetricsRestoreSource() {
+    return restore_source;
+}
@@ -1,5 +1,10 @@
 #include "mqtt_client.h"
+#include "mqtt_topics.h"
 #include <WiFi.h>
+#include <esp_random.h>
+#include <esp_rom_crc.h>
+#include <esp_timer.h>
+#include <lwip/dns.h>
 
 // Static instance pointer
 PowerwallMQTTClient* PowerwallMQTTClient::instance = nullptr;
@@ -7,14 +12,47 @@ PowerwallMQTTClient* PowerwallMQTTClient::instance = nullptr;
 // Global instance
 PowerwallMQTTClient mqttClient;
 
+// Hostname lookup result from the lwIP task, tagged with the lookup it answers.
+// Written and read as a pair under dns_mux.
+static portMUX_TYPE dns_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t dns_done_seq = 0;
+static uint32_t dns_done_addr = 0;  // 0 = lookup failed
+
+static void onDnsFound(const char *, const ip_addr_t *ipaddr, void *arg) {
+    const uint32_t addr = (ipaddr && IP_IS_V4(ipaddr)) ? ip4_addr_get_u32(ip_2_ip4(ipaddr)) : 0;
+    portENTER_CRITICAL(&dns_mux);
+    dns_done_addr = addr;
+    dns_done_seq = (uint8_t)(uintptr_t)arg;
+    portEXIT_CRITICAL(&dns_mux);
+}
+
+// Guards the ingest slots shared with the async TCP task
+static portMUX_TYPE mqtt_ingest_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Spread reconnects of many displays: half the delay fixed, half random
+static unsigned long jittered(unsigned long delay_ms) {
+    const unsigned long half = delay_ms / 2;
+    return half + (half > 0 ? esp_random() % half : 0);
+}
+
 PowerwallMQTTClient::PowerwallMQTTClient()
     : solarCallback(nullptr), gridCallback(nullptr), homeCallback(nullptr),
       batteryCallback(nullptr), socCallback(nullptr), offGridCallback(nullptr),
       timeRemainingCallback(nullptr), evCallback(nullptr), evConnectedCallback(nullptr),
-      evSOCCallback(nullptr), last_ev_power(0.0f), reconnect_enabled(false),
-      last_reconnect_attempt(0), reconnect_delay(MQTT_RECONNECT_MIN_DELAY) {
+      evSOCCallback(nullptr), last_ev_power(0.0f), extra_node_count(0), extraNodeCallback(nullptr),
+      reconnect_enabled(false),
+      next_attempt_at(0), reconnect_delay(MQTT_RECONNECT_MIN_DELAY),
+      endpoint_count(0), active_endpoint(-1), connecting(false), resolving(false), resolve_seq(0),
+      session_up(false), connect_started(0), connect_event(false), disconnect_event(false), connect_event_ms(0),
+      bootstrap_stats(), received_mask(0), filled_mask(0), subscribed_signature(0), companion_published_at(),
+      ingest_slots(), ingest_pending_mask(0), ingest_next_channel(0), ingest_tokens(MQTT_INGEST_CHANNELS),
+      ingest_refill_ms(0), ingest_stats() {
     instance = this;
 
+    // Stable per device, so a persistent session can be resumed
+    uint64_t mac = ESP.getEfuseMac();
+    snprintf(client_id, sizeof(client_id), "powerwall-display-%06llx", (unsigned long long)(mac >> 24));
+
     // Set up async MQTT callbacks
     mqtt_client.onConnect(onMqttConnectStatic);
     mqtt_client.onDisconnect(onMqttDisconnectStatic);
@@ -25,38 +63,60 @@ void PowerwallMQTTClient::begin() {
     loadConfig();
     
     if (config.host.length() > 0) {
-        mqtt_client.setServer(config.host.c_str(), config.port);
-        
-        if (config.user.length() > 0) {
-            mqtt_client.setCredentials(config.user.c_str(), config.password.c_str());
-        }
+        rebuildEndpoints();
+        applyClientOptions();
         
         // Don't connect yet - wait for WiFi to be ready
-        Serial.printf("MQTT client initialized - Server: %s:%d (waiting for WiFi)\n", config.host.c_str(), config.port);
+        Serial.printf("MQTT client initialized - Server: %s:%d, %d fallback(s) (waiting for WiFi)\n",
+                      config.host.c_str(), config.port, endpoint_count - 1);
     } else {
         Serial.println("MQTT not configured - skipping initialization");
     }
 }
 
 void PowerwallMQTTClient::loop() {
-    // Handle auto-reconnect with exponential backoff
-    if (!reconnect_enabled || mqtt_client.connected()) {
-        return;
+    // Attempt results reported by the async TCP task
+    if (connect_event) {
+        connect_event = false;
+        handleConnected();
+    }
+    if (disconnect_event) {
+        disconnect_event = false;
+        handleDisconnected();
     }
 
-    if (WiFi.status() != WL_CONNECTED || config.host.length() == 0) {
-        return;
+    if (connecting && resolving) {
+        portENTER_CRITICAL(&dns_mux);
+        const bool answered = dns_done_seq == resolve_seq;
+        const uint32_t addr = dns_done_addr;
+        portEXIT_CRITICAL(&dns_mux);
+        if (answered) finishResolve(addr);
     }
 
+    // Messages queued by onMqttMessage
+    processIngest();
+
     unsigned long now = millis();
-    if (now - last_reconnect_attempt >= reconnect_delay) {
-        last_reconnect_attempt = now;
 
-        Serial.printf("Attempting MQTT reconnect (delay: %lums)...\n", reconnect_delay);
-        mqtt_client.connect();
+    // A broker that is down often never refuses, it just doesn't answer
+    if (connecting && now - connect_started > MQTT_CONNECT_TIMEOUT) {
+        Serial.println(resolving ? "✗ MQTT broker DNS lookup timed out" : "✗ MQTT connect timed out");
+        cancelAttempt();
+        mqtt_client.disconnect(true);
+        onAttemptFailed();
+    }
 
-        // Exponential backoff: double delay up to max
-        reconnect_delay = min(reconnect_delay * 2, (unsigned long)MQTT_RECONNECT_MAX_DELAY);
+    // Handle auto-reconnect with jittered exponential backoff
+    if (!reconnect_enabled || connecting || mqtt_client.connected()) {
+        return;
+    }
+
+    if (WiFi.status() != WL_CONNECTED || config.host.length() == 0) {
+        return;
+    }
+
+    if ((long)(now - next_attempt_at) >= 0) {
+        startAttempt();
     }
 }
 
@@ -67,27 +127,47 @@ void PowerwallMQTTClient::loadConfig() {
     config.user = preferences.getString("user", "");
     config.password = preferences.getString("password", "");
     config.topic_prefix = preferences.getString("prefix", "pypowerwall/");
+    config.fallback_brokers = preferences.getString("fallbacks", "");
+    config.wildcard_subscribe = preferences.getBool("wildcard", false);
+    config.subscribe_filter = preferences.getString("sub_filter", "");
+    config.clean_session = preferences.getBool("clean", true);
+    if (preferences.getBytes("qos", config.topic_qos, sizeof(config.topic_qos)) != sizeof(config.topic_qos)) {
+        memset(config.topic_qos, 0, sizeof(config.topic_qos));
+    }
+    config.ev_qos = preferences.getUChar("ev_qos", 0);
+    config.bootstrap_prefix = preferences.getString("bootstrap", "");
+    config.max_rate = preferences.getUShort("max_rate", MQTT_INGEST_DEFAULT_RATE);
 
     // EV configuration
     config.ev_enabled = preferences.getBool("ev_enabled", false);
     config.ev_power_topic = preferences.getString("ev_power", "");
     config.ev_connected_topic = preferences.getString("ev_conn", "");
     config.ev_soc_topic = preferences.getString("ev_soc", "");
+    config.extra_nodes = preferences.getString("extra_nodes", "");
     preferences.end();
+    rebuildExtraNodes();
 
     Serial.println("─────────────────────────────────");
     Serial.println("MQTT Configuration Loaded:");
     Serial.printf("  Host: %s\n", config.host.length() > 0 ? config.host.c_str() : "(not configured)");
     Serial.printf("  Port: %d\n", config.port);
+    Serial.printf("  Fallbacks: %s\n", config.fallback_brokers.length() > 0 ? config.fallback_brokers.c_str() : "(none)");
     Serial.printf("  User: %s\n", config.user.length() > 0 ? config.user.c_str() : "(none)");
     Serial.printf("  Password: %s\n", config.password.length() > 0 ? "***" : "(none)");
     Serial.printf("  Topic Prefix: %s\n", config.topic_prefix.c_str());
+    Serial.printf("  Subscribe: %s\n", config.wildcard_subscribe ? getSubscribeFilter().c_str() : "per topic");
+    Serial.printf("  Session: %s\n", config.clean_session ? "clean" : "persistent");
+    Serial.printf("  Bootstrap Topic: %s\n", config.bootstrap_prefix.length() > 0 ? config.bootstrap_prefix.c_str() : "(none)");
     Serial.printf("  EV Enabled: %s\n", config.ev_enabled ? "yes" : "no");
     if (config.ev_enabled) {
         Serial.printf("  EV Power Topic: %s\n", config.ev_power_topic.c_str());
         Serial.printf("  EV Connected Topic: %s\n", config.ev_connected_topic.length() > 0 ? config.ev_connected_topic.c_str() : "(not configured)");
         Serial.printf("  EV SOC Topic: %s\n", config.ev_soc_topic.length() > 0 ? config.ev_soc_topic.c_str() : "(not configured)");
     }
+    for (uint8_t i = 0; i < extra_node_count; i++) {
+        Serial.printf("  Extra Node %d: %s <- %s\n", i + 1, getPowerNodeRoleName(extra_node_list[i].role),
+                      extra_node_list[i].topic.c_str());
+    }
     Serial.println("─────────────────────────────────");
 }
 
@@ -98,37 +178,335 @@ void PowerwallMQTTClient::saveConfig() {
     preferences.putString("user", config.user);
     preferences.putString("password", config.password);
     preferences.putString("prefix", config.topic_prefix);
+    preferences.putString("fallbacks", config.fallback_brokers);
+    preferences.putBool("wildcard", config.wildcard_subscribe);
+    preferences.putString("sub_filter", config.subscribe_filter);
+    preferences.putBool("clean", config.clean_session);
+    preferences.putBytes("qos", config.topic_qos, sizeof(config.topic_qos));
+    preferences.putUChar("ev_qos", config.ev_qos);
+    preferences.putString("bootstrap", config.bootstrap_prefix);
+    preferences.putUShort("max_rate", config.max_rate);
 
     // EV configuration
     preferences.putBool("ev_enabled", config.ev_enabled);
     preferences.putString("ev_power", config.ev_power_topic);
     preferences.putString("ev_conn", config.ev_connected_topic);
     preferences.putString("ev_soc", config.ev_soc_topic);
+    preferences.putString("extra_nodes", config.extra_nodes);
     preferences.end();
+    rebuildExtraNodes();
 
     Serial.println("✓ MQTT Config saved to flash");
     
     // Reinitialize with new config
     if (config.host.length() > 0) {
         Serial.println("→ Reinitializing MQTT with new config...");
+        cancelAttempt();
         mqtt_client.disconnect();
-        mqtt_client.setServer(config.host.c_str(), config.port);
-        
-        if (config.user.length() > 0) {
-            mqtt_client.setCredentials(config.user.c_str(), config.password.c_str());
-        } else {
-            mqtt_client.setCredentials(nullptr, nullptr);
-        }
+        rebuildEndpoints();
+        applyClientOptions();
         
-        // Only connect if WiFi is already connected
-        if (WiFi.status() == WL_CONNECTED) {
-            mqtt_client.connect();
-        } else {
+        // Reconnect from loop() once the old session is closed (only if WiFi is up)
+        reconnect_enabled = true;
+        reconnect_delay = MQTT_RECONNECT_MIN_DELAY;
+        next_attempt_at = millis();
+        if (WiFi.status() != WL_CONNECTED) {
             Serial.println("→ WiFi not connected, will connect to MQTT when WiFi is ready");
         }
     }
 }
 
+// "role:topic,..." into the extra node list. Unknown roles, solar, grid and
+// home (one each, from pypowerwall) are skipped. Last values are kept for
+// nodes that did not change.
+void PowerwallMQTTClient::rebuildExtraNodes() {
+    MQTTExtraNode previous[MQTT_MAX_EXTRA_NODES];
+    const uint8_t previous_count = extra_node_count;
+    for (uint8_t i = 0; i < previous_count; i++) previous[i] = extra_node_list[i];
+
+    extra_node_count = 0;
+    int start = 0;
+    const String &list = config.extra_nodes;
+    while (start < (int)list.length() && extra_node_count < MQTT_MAX_EXTRA_NODES) {
+        int end = list.indexOf(',', start);
+        if (end < 0) end = list.length();
+        String entry = list.substring(start, end);
+        start = end + 1;
+
+        int colon = entry.indexOf(':');
+        if (colon <= 0) continue;
+        String role_name = entry.substring(0, colon);
+        String topic = entry.substring(colon + 1);
+        role_name.trim();
+        role_name.toLowerCase();
+        topic.trim();
+
+        const PowerNodeRole role = parsePowerNodeRole(role_name.c_str());
+        if (topic.length() == 0 ||
+            (role != NODE_GENERATOR && role != NODE_BATTERY && role != NODE_EV)) {
+            Serial.printf("✗ Ignoring extra node '%s'\n", entry.c_str());
+            continue;
+        }
+
+        MQTTExtraNode &node = extra_node_list[extra_node_count++];
+        node.role = role;
+        node.topic = topic;
+        node.last_w = 0.0f;
+        for (uint8_t i = 0; i < previous_count; i++) {
+            if (previous[i].role == role && previous[i].topic == topic) {
+                node.last_w = previous[i].last_w;
+                break;
+            }
+        }
+    }
+}
+
+// Primary from host/port, then the fallback list. Cached DNS results and
+// latency history are kept for endpoints that did not change.
+void PowerwallMQTTClient::rebuildEndpoints() {
+    MQTTEndpoint previous[MQTT_MAX_ENDPOINTS];
+    const uint8_t previous_count = endpoint_count;
+    for (uint8_t i = 0; i < previous_count; i++) previous[i] = endpoints[i];
+
+    endpoint_count = 0;
+    active_endpoint = -1;
+
+    auto add = [&](const String &host, uint16_t port) {
+        if (host.length() == 0 || endpoint_count >= MQTT_MAX_ENDPOINTS) return;
+        MQTTEndpoint &endpoint = endpoints[endpoint_count++];
+        endpoint = MQTTEndpoint();
+        endpoint.host = host;
+        endpoint.port = port;
+        for (uint8_t i = 0; i < previous_count; i++) {
+            if (previous[i].host == host && previous[i].port == port) {
+                endpoint = previous[i];
+                break;
+            }
+        }
+        IPAddress ip;
+        endpoint.literal = ip.fromString(host);
+        if (endpoint.literal) {
+            endpoint.addr = ip;
+            endpoint.resolved_at = 1;
+        }
+    };
+
+    add(config.host, config.port);
+
+    int start = 0;
+    const String &list = config.fallback_brokers;
+    while (start < (int)list.length()) {
+        int end = list.indexOf(',', start);
+        if (end < 0) end = list.length();
+        String entry = list.substring(start, end);
+        entry.trim();
+        start = end + 1;
+
+        uint16_t port = config.port;
+        int colon = entry.lastIndexOf(':');
+        if (colon > 0) {
+            port = entry.substring(colon + 1).toInt();
+            entry = entry.substring(0, colon);
+        }
+        if (port > 0) add(entry, port);
+    }
+}
+
+void PowerwallMQTTClient::applyClientOptions() {
+    if (config.user.length() > 0) {
+        mqtt_client.setCredentials(config.user.c_str(), config.password.c_str());
+    } else {
+        mqtt_client.setCredentials(nullptr, nullptr);
+    }
+    mqtt_client.setClientId(client_id);
+    mqtt_client.setCleanSession(config.clean_session);
+}
+
+// Changes whenever the set of subscriptions would change
+uint32_t PowerwallMQTTClient::subscriptionSignature() {
+    String key = config.topic_prefix + '|' + (config.wildcard_subscribe ? getSubscribeFilter() : String()) + '|' +
+                 config.bootstrap_prefix + '|';
+    if (config.ev_enabled) {
+        key += config.ev_power_topic + '|' + config.ev_connected_topic + '|' + config.ev_soc_topic;
+    }
+    for (uint8_t i = 0; i < extra_node_count; i++) {
+        key += '|' + extra_node_list[i].topic;
+    }
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)key.c_str(), key.length());
+    crc = esp_rom_crc32_le(crc, config.topic_qos, sizeof(config.topic_qos));
+    return esp_rom_crc32_le(crc, &config.ev_qos, 1);
+}
+
+// Lowest connect latency among endpoints not cooling down after a failure.
+// Never-connected endpoints score MQTT_LATENCY_UNKNOWN, ties go to the primary.
+int PowerwallMQTTClient::selectEndpoint() {
+    const unsigned long now = millis();
+    int best = -1;
+    float best_score = 0;
+    int oldest_failure = -1;
+
+    for (uint8_t i = 0; i < endpoint_count; i++) {
+        const MQTTEndpoint &endpoint = endpoints[i];
+        if (endpoint.failed_at != 0 && now - endpoint.failed_at < MQTT_ENDPOINT_COOLDOWN) {
+            if (oldest_failure < 0 || (long)(endpoint.failed_at - endpoints[oldest_failure].failed_at) < 0) {
+                oldest_failure = i;
+            }
+            continue;
+        }
+        const float score = endpoint.latency_ms > 0 ? endpoint.latency_ms : MQTT_LATENCY_UNKNOWN;
+        if (best < 0 || score < best_score) {
+            best = i;
+            best_score = score;
+        }
+    }
+
+    // Everything failed recently: retry the one that failed longest ago
+    return best >= 0 ? best : oldest_failure;
+}
+
+bool PowerwallMQTTClient::endpointResolved(const MQTTEndpoint &endpoint) {
+    if (endpoint.literal) return true;
+    return endpoint.resolved_at != 0 && millis() - endpoint.resolved_at < MQTT_DNS_CACHE_TTL;
+}
+
+void PowerwallMQTTClient::startAttempt() {
+    if (endpoint_count == 0) rebuildEndpoints();
+    active_endpoint = selectEndpoint();
+    if (active_endpoint < 0) return;
+
+    MQTTEndpoint &endpoint = endpoints[active_endpoint];
+    connecting = true;
+    connect_started = millis();
+    if (endpointResolved(endpoint)) {
+        resolving = false;
+        connectEndpoint(endpoint);
+        return;
+    }
+
+    // Look the host up without blocking loop(); the answer arrives via onDnsFound
+    // (or right away from lwIP's cache), and the attempt timeout covers the lookup
+    ip_addr_t addr;
+    resolving = true;
+    resolve_seq++;
+    const err_t err = dns_gethostbyname(endpoint.host.c_str(), &addr, onDnsFound, (void *)(uintptr_t)resolve_seq);
+    if (err == ERR_OK) {
+        finishResolve(IP_IS_V4(&addr) ? ip4_addr_get_u32(ip_2_ip4(&addr)) : 0);
+    } else if (err != ERR_INPROGRESS) {
+        finishResolve(0);
+    }
+}
+
+void PowerwallMQTTClient::finishResolve(uint32_t addr) {
+    resolving = false;
+    // saveConfig() on the TCP task may have rebuilt the endpoint list meanwhile
+    if (active_endpoint < 0) {
+        cancelAttempt();
+        return;
+    }
+    MQTTEndpoint &endpoint = endpoints[active_endpoint];
+    if (addr == 0) {
+        Serial.printf("✗ DNS lookup failed for %s\n", endpoint.host.c_str());
+        onAttemptFailed();
+        return;
+    }
+
+    endpoint.addr = IPAddress(addr);
+    endpoint.resolved_at = millis();
+    if (endpoint.resolved_at == 0) endpoint.resolved_at = 1;
+    connectEndpoint(endpoint);
+}
+
+void PowerwallMQTTClient::connectEndpoint(MQTTEndpoint &endpoint) {
+    Serial.printf("→ Connecting to MQTT broker %s:%d (%s)", endpoint.host.c_str(), endpoint.port,
+                  endpoint.addr.toString().c_str());
+    if (config.user.length() > 0) {
+        Serial.printf(" (user: %s)", config.user.c_str());
+    }
+    Serial.println("...");
+
+    connect_started = millis();
+    mqtt_client.setServer(endpoint.addr, endpoint.port);
+    mqtt_client.connect();
+}
+
+// Ends the attempt in progress. Bumping the sequence makes a DNS answer that
+// is still in flight stale, so it can't start a second connect.
+void PowerwallMQTTClient::cancelAttempt() {
+    connecting = false;
+    resolving = false;
+    resolve_seq++;
+}
+
+void PowerwallMQTTClient::scheduleAttempt(unsigned long delay_ms) {
+    next_attempt_at = millis() + jittered(delay_ms);
+}
+
+void PowerwallMQTTClient::onAttemptFailed() {
+    cancelAttempt();
+    if (active_endpoint < 0) return;
+
+    MQTTEndpoint &endpoint = endpoints[active_endpoint];
+    endpoint.failures++;
+    endpoint.failed_at = millis();
+    if (endpoint.failed_at == 0) endpoint.failed_at = 1;
+    // The broker may have moved; look it up again next time
+    if (!endpoint.literal) endpoint.resolved_at = 0;
+
+    // Fail over right away if another endpoint is available, else back off
+    bool other_available = false;
+    for (uint8_t i = 0; i < endpoint_count; i++) {
+        if (i != active_endpoint && (endpoints[i].failed_at == 0 ||
+            millis() - endpoints[i].failed_at >= MQTT_ENDPOINT_COOLDOWN)) {
+            other_available = true;
+        }
+    }
+
+    if (other_available) {
+        Serial.printf("✗ MQTT broker %s:%d failed, failing over\n", endpoint.host.c_str(), endpoint.port);
+        scheduleAttempt(MQTT_FAILOVER_DELAY);
+    } else {
+        Serial.printf("✗ MQTT broker %s:%d failed, retrying in ~%lums\n",
+                      endpoint.host.c_str(), endpoint.port, reconnect_delay);
+        scheduleAttempt(reconnect_delay);
+        // Exponential backoff: double delay up to max
+        reconnect_delay = min(reconnect_delay * 2, (unsigned long)MQTT_RECONNECT_MAX_DELAY);
+    }
+}
+
+void PowerwallMQTTClient::handleConnected() {
+    if (!connecting || active_endpoint < 0) return;
+    cancelAttempt();
+    session_up = true;
+    reconnect_delay = MQTT_RECONNECT_MIN_DELAY;  // Reset backoff
+
+    MQTTEndpoint &endpoint = endpoints[active_endpoint];
+    const float latency = (float)(connect_event_ms - connect_started);
+    endpoint.latency_ms = endpoint.latency_ms > 0
+        ? endpoint.latency_ms + MQTT_LATENCY_EWMA_ALPHA * (latency - endpoint.latency_ms)
+        : latency;
+    endpoint.connects++;
+    endpoint.failed_at = 0;
+    Serial.printf("✓ MQTT connected to %s:%d in %lu ms\n", endpoint.host.c_str(), endpoint.port,
+                  (unsigned long)latency);
+}
+
+void PowerwallMQTTClient::handleDisconnected() {
+    if (resolving) {
+        return;  // Left over from the previous session; this attempt hasn't connected yet
+    }
+    if (connecting) {
+        // Refused or unreachable
+        onAttemptFailed();
+    } else if (session_up) {
+        session_up = false;
+        // Lost an established session: reconnect quickly, the attempt fails over if needed
+        if (reconnect_enabled && WiFi.status() == WL_CONNECTED && config.host.length() > 0) {
+            scheduleAttempt(MQTT_RECONNECT_MIN_DELAY);
+            Serial.printf("Will attempt to reconnect in ~%dms...\n", MQTT_RECONNECT_MIN_DELAY);
+        }
+    }
+}
+
 bool PowerwallMQTTClient::isConnected() {
     return mqtt_client.connected();
 }
@@ -137,8 +515,13 @@ MQTTConfig& PowerwallMQTTClient::getConfig() {
     return config;
 }
 
+String PowerwallMQTTClient::getSubscribeFilter() {
+    return config.subscribe_filter.length() > 0 ? config.subscribe_filter : config.topic_prefix + "#";
+}
+
 void PowerwallMQTTClient::disconnect() {
     reconnect_enabled = false;  // Disable auto-reconnect on explicit disconnect
+    cancelAttempt();
     mqtt_client.disconnect();
 }
 
@@ -153,14 +536,62 @@ void PowerwallMQTTClient::connect() {
         Serial.println("✗ Cannot connect to MQTT - not configured");
         return;
     }
-    
-    Serial.printf("→ Connecting to MQTT broker at %s:%d", config.host.c_str(), config.port);
-    if (config.user.length() > 0) {
-        Serial.printf(" (user: %s)", config.user.c_str());
+
+    reconnect_enabled = true;
+    reconnect_delay = MQTT_RECONNECT_MIN_DELAY;
+    if (!connecting && !mqtt_client.connected()) {
+        startAttempt();
     }
-    Serial.println("...");
-    
-    mqtt_client.connect();
+}
+
+void PowerwallMQTTClient::reinit() {
+    if (config.host.length() == 0) return;
+
+    Serial.println("→ Reinitializing MQTT client...");
+    cancelAttempt();
+    mqtt_client.disconnect(true);  // Close the socket without waiting for the broker
+    rebuildEndpoints();
+    // Forget cached addresses and failures, start over from the primary
+    for (uint8_t i = 0; i < endpoint_count; i++) {
+        if (!endpoints[i].literal) endpoints[i].resolved_at = 0;
+        endpoints[i].failed_at = 0;
+    }
+    applyClientOptions();
+
+    // Reconnect from loop() with the backoff reset
+    reconnect_enabled = true;
+    reconnect_delay = MQTT_RECONNECT_MIN_DELAY;
+    scheduleAttempt(MQTT_RECONNECT_MIN_DELAY);
+}
+
+uint8_t PowerwallMQTTClient::getEndpointCount() {
+    return endpoint_count;
+}
+
+const MQTTEndpoint& PowerwallMQTTClient::getEndpoint(uint8_t index) {
+    return endpoints[index < endpoint_count ? index : 0];
+}
+
+const MQTTIngestStats& PowerwallMQTTClient::getIngestStats() {
+    return ingest_stats;
+}
+
+void PowerwallMQTTClient::resetIngestStats() {
+    ingest_stats = MQTTIngestStats();
+    bootstrap_stats.retained_received = 0;
+    bootstrap_stats.companion_applied = 0;
+}
+
+const char* PowerwallMQTTClient::getClientId() {
+    return client_id;
+}
+
+const MQTTBootstrapStats& PowerwallMQTTClient::getBootstrapStats() {
+    return bootstrap_stats;
+}
+
+int PowerwallMQTTClient::getActiveEndpoint() {
+    return mqtt_client.connected() ? active_endpoint : -1;
 }
 
 void PowerwallMQTTClient::setSolarCallback(void (*callback)(float)) {
@@ -203,6 +634,18 @@ void PowerwallMQTTClient::setEVSOCCallback(void (*callback)(float)) {
     evSOCCallback = callback;
 }
 
+uint8_t PowerwallMQTTClient::getExtraNodeCount() {
+    return extra_node_count;
+}
+
+const MQTTExtraNode& PowerwallMQTTClient::getExtraNode(uint8_t index) {
+    return extra_node_list[index < extra_node_count ? index : 0];
+}
+
+void PowerwallMQTTClient::setExtraNodeCallback(void (*callback)(uint8_t, float)) {
+    extraNodeCallback = callback;
+}
+
 // Static callback wrappers
 void PowerwallMQTTClient::onMqttConnectStatic(bool sessionPresent) {
     if (instance) {
@@ -226,38 +669,79 @@ void PowerwallMQTTClient::onMqttMessageStatic(char* topic, char* payload, AsyncM
 void PowerwallMQTTClient::onMqttConnect(bool sessionPresent) {
     Serial.println("✓ Connected to MQTT broker");
 
-    // Reset reconnect state on successful connection
-    reconnect_enabled = true;  // Enable auto-reconnect for future disconnects
-    reconnect_delay = MQTT_RECONNECT_MIN_DELAY;  // Reset backoff
-    
-    // Subscribe to all pypowerwall topics
+    // Latency and backoff bookkeeping happen in loop()
+    connect_event_ms = millis();
+    connect_event = true;
+
+    // Retained values arrive right after the subscribe; time until the dashboard is complete
+    received_mask = 0;
+    filled_mask = 0;
+    bootstrap_stats.last_bootstrap_ms = 0;
+    bootstrap_stats.session_present = sessionPresent;
+
+    // A resumed session still has our subscriptions (and queued QoS 1 messages)
+    const uint32_t signature = subscriptionSignature();
+    bootstrap_stats.resubscribed = !(sessionPresent && !config.clean_session && signature == subscribed_signature);
+    if (!bootstrap_stats.resubscribed) {
+        Serial.println("✓ Resumed persistent MQTT session, subscriptions kept");
+        return;
+    }
+    subscribed_signature = signature;
+
     String prefix = config.topic_prefix;
-    
-    mqtt_client.subscribe((prefix + "site/instant_power").c_str(), 0);
-    mqtt_client.subscribe((prefix + "battery/instant_power").c_str(), 0);
-    mqtt_client.subscribe((prefix + "solar/instant_power").c_str(), 0);
-    mqtt_client.subscribe((prefix + "load/instant_power").c_str(), 0);
-    mqtt_client.subscribe((prefix + "battery/level").c_str(), 0);
-    mqtt_client.subscribe((prefix + "site/offgrid").c_str(), 0);
-    mqtt_client.subscribe((prefix + "battery/time_remaining").c_str(), 0);
+    String filter;
 
-    Serial.printf("✓ Subscribed to MQTT topics with prefix: %s\n", prefix.c_str());
+    if (config.wildcard_subscribe) {
+        // One subscription for everything under the prefix; onMqttMessage drops what it doesn't know
+        uint8_t qos = 0;
+        for (uint8_t i = 0; i < TOPIC_COUNT; i++) qos = max(qos, config.topic_qos[i]);
+        filter = getSubscribeFilter();
+        mqtt_client.subscribe(filter.c_str(), qos);
+        Serial.printf("✓ Subscribed to MQTT filter: %s (QoS %d)\n", filter.c_str(), qos);
+    } else {
+        // Subscribe to all pypowerwall topics
+        for (uint8_t i = 0; i < TOPIC_COUNT; i++) {
+            mqtt_client.subscribe((prefix + getPowerwallTopicSuffix((PowerwallTopic)i)).c_str(), config.topic_qos[i]);
+        }
+        Serial.printf("✓ Subscribed to MQTT topics with prefix: %s\n", prefix.c_str());
+    }
+
+    // Companion last values, only used until the live topic has been seen
+    if (config.bootstrap_prefix.length() > 0) {
+        String companion = config.bootstrap_prefix + "#";
+        if (filter.length() == 0 || !mqttTopicMatchesFilter(filter.c_str(), config.bootstrap_prefix.c_str())) {
+            mqtt_client.subscribe(companion.c_str(), 0);
+            Serial.printf("✓ Subscribed to bootstrap topic: %s\n", companion.c_str());
+        }
+    }
 
     // Subscribe to EV topics if enabled (these use full topic paths, not prefix)
     if (config.ev_enabled) {
-        if (config.ev_power_topic.length() > 0) {
-            mqtt_client.subscribe(config.ev_power_topic.c_str(), 0);
-            Serial.printf("✓ Subscribed to EV power topic: %s\n", config.ev_power_topic.c_str());
-        }
-        if (config.ev_connected_topic.length() > 0) {
-            mqtt_client.subscribe(config.ev_connected_topic.c_str(), 0);
-            Serial.printf("✓ Subscribed to EV connected topic: %s\n", config.ev_connected_topic.c_str());
-        }
-        if (config.ev_soc_topic.length() > 0) {
-            mqtt_client.subscribe(config.ev_soc_topic.c_str(), 0);
-            Serial.printf("✓ Subscribed to EV SOC topic: %s\n", config.ev_soc_topic.c_str());
+        const String *ev_topics[] = { &config.ev_power_topic, &config.ev_connected_topic, &config.ev_soc_topic };
+        for (const String *topic : ev_topics) {
+            if (topic->length() == 0) continue;
+            if (filter.length() > 0 && mqttTopicMatchesFilter(filter.c_str(), topic->c_str())) continue;
+            mqtt_client.subscribe(topic->c_str(), config.ev_qos);
+            Serial.printf("✓ Subscribed to EV topic: %s\n", topic->c_str());
         }
     }
+
+    // Extra flow nodes (full topic paths, same QoS as the EV topics)
+    for (uint8_t i = 0; i < extra_node_count; i++) {
+        const String &topic = extra_node_list[i].topic;
+        if (filter.length() > 0 && mqttTopicMatchesFilter(filter.c_str(), topic.c_str())) continue;
+        mqtt_client.subscribe(topic.c_str(), config.ev_qos);
+        Serial.printf("✓ Subscribed to %s topic: %s\n", getPowerNodeRoleName(extra_node_list[i].role), topic.c_str());
+    }
+}
+
+// Republish a live value, retained, so the next connect (ours or another display's) starts complete
+void PowerwallMQTTClient::publishCompanion(PowerwallTopic topic, const char *message) {
+    if (config.bootstrap_prefix.length() == 0) return;
+    const unsigned long now = millis();
+    if (companion_published_at[topic] != 0 && now - companion_published_at[topic] < MQTT_BOOTSTRAP_PUBLISH_INTERVAL) return;
+    companion_published_at[topic] = now ? now : 1;
+    mqtt_client.publish((config.bootstrap_prefix + getPowerwallTopicSuffix(topic)).c_str(), 0, true, message);
 }
 
 void PowerwallMQTTClient::onMqttDisconnect(AsyncMqttClientDisconnectReason reason) {
@@ -286,31 +770,122 @@ void PowerwallMQTTClient::onMqttDisconnect(AsyncMqttClientDisconnectReason reaso
             break;
     }
     
-    // Enable auto-reconnect if WiFi is still connected
-    if (WiFi.status() == WL_CONNECTED && config.host.length() > 0) {
-        reconnect_enabled = true;
-        last_reconnect_attempt = millis();  // Start backoff timer
-        Serial.printf("Will attempt to reconnect in %lums...\n", reconnect_delay);
-    }
+    // Failover and reconnect are decided in loop()
+    disconnect_event = true;
 }
 
+// Runs on the async TCP task: classify, then park the payload in its
+// channel's slot (latest value wins). Parsing, logging and the UI callbacks
+// happen in loop() via processIngest(), at a bounded rate.
 void PowerwallMQTTClient::onMqttMessage(char* topic, char* payload, AsyncMqttClientMessageProperties properties, size_t len, size_t index, size_t total) {
+    ingest_stats.received++;
+
+    // Classify the topic first so unrelated ones (wildcard mode) cost one prefix compare
+    uint8_t channel = TOPIC_UNKNOWN;
+    bool is_companion = false;
+
+    if (config.ev_enabled) {
+        if (config.ev_power_topic.length() > 0 && config.ev_power_topic == topic) channel = MQTT_INGEST_EV_POWER;
+        else if (config.ev_connected_topic.length() > 0 && config.ev_connected_topic == topic) channel = MQTT_INGEST_EV_CONNECTED;
+        else if (config.ev_soc_topic.length() > 0 && config.ev_soc_topic == topic) channel = MQTT_INGEST_EV_SOC;
+    }
+    for (uint8_t i = 0; i < extra_node_count && channel == TOPIC_UNKNOWN; i++) {
+        if (extra_node_list[i].topic == topic) channel = MQTT_INGEST_EXTRA + i;
+    }
+    const size_t bootstrap_len = config.bootstrap_prefix.length();
+    if (channel != TOPIC_UNKNOWN) {
+        // EV or extra node topic
+    } else if (bootstrap_len > 0 && strncmp(topic, config.bootstrap_prefix.c_str(), bootstrap_len) == 0) {
+        channel = matchPowerwallTopic(topic + bootstrap_len);
+        is_companion = true;
+    } else {
+        const size_t prefix_len = config.topic_prefix.length();
+        if (strncmp(topic, config.topic_prefix.c_str(), prefix_len) == 0) {
+            channel = matchPowerwallTopic(topic + prefix_len);
+        }
+    }
+    if (channel == TOPIC_UNKNOWN) {
+        ingest_stats.ignored++;
+        return;
+    }
+    if (properties.retain) bootstrap_stats.retained_received++;
+
     // Limit message size to prevent stack overflow
-    if (len > MAX_MQTT_MESSAGE_SIZE) {
-        Serial.printf("✗ MQTT message too large (%d bytes), ignoring\n", len);
+    if (len > MAX_MQTT_MESSAGE_SIZE || index > 0 || len != total) {
+        ingest_stats.oversized++;
         return;
     }
-    
-    // Convert payload to null-terminated string
-    char message[MAX_MQTT_MESSAGE_SIZE + 1];
-    memcpy(message, payload, len);
-    message[len] = '\0';
-    
-    String topicStr = String(topic);
-    String prefix = config.topic_prefix;
+
+    portENTER_CRITICAL(&mqtt_ingest_mux);
+    IngestSlot &slot = ingest_slots[channel];
+    const uint32_t bit = 1U << channel;
+    if (is_companion && ((received_mask & bit) || ((ingest_pending_mask & bit) && !slot.companion))) {
+        // Stale next to a live value
+        portEXIT_CRITICAL(&mqtt_ingest_mux);
+        ingest_stats.ignored++;
+        return;
+    }
+    if (ingest_pending_mask & bit) ingest_stats.coalesced++;
+    memcpy(slot.payload, payload, len);
+    slot.payload[len] = '\0';
+    slot.companion = is_companion;
+    ingest_pending_mask |= bit;
+    if (!is_companion) received_mask |= bit;
+    portEXIT_CRITICAL(&mqtt_ingest_mux);
+}
+
+// Drain pending slots, at most max_rate per second (token bucket)
+void PowerwallMQTTClient::processIngest() {
+    if (ingest_pending_mask == 0) return;
+
+    const unsigned long now = millis();
+    if (config.max_rate > 0) {
+        ingest_tokens = min((float)MQTT_INGEST_CHANNELS,
+                            ingest_tokens + (now - ingest_refill_ms) * config.max_rate / 1000.0f);
+    }
+    ingest_refill_ms = now;
+
+    // Round-robin so one busy topic can't starve the others
+    for (uint8_t n = 0; n < MQTT_INGEST_CHANNELS; n++) {
+        const uint8_t channel = ingest_next_channel;
+        const uint32_t bit = 1U << channel;
+        if (!(ingest_pending_mask & bit)) {
+            ingest_next_channel = (channel + 1) % MQTT_INGEST_CHANNELS;
+            continue;
+        }
+
+        // Out of budget: resume from this channel next time
+        if (config.max_rate > 0) {
+            if (ingest_tokens < 1.0f) {
+                ingest_stats.rate_limited++;
+                return;
+            }
+            ingest_tokens -= 1.0f;
+        }
+        ingest_next_channel = (channel + 1) % MQTT_INGEST_CHANNELS;
+
+        char message[MAX_MQTT_MESSAGE_SIZE + 1];
+        portENTER_CRITICAL(&mqtt_ingest_mux);
+        const IngestSlot &slot = ingest_slots[channel];
+        memcpy(message, slot.payload, sizeof(message));
+        const bool companion = slot.companion;
+        ingest_pending_mask &= ~bit;
+        portEXIT_CRITICAL(&mqtt_ingest_mux);
+
+        const int64_t started_us = esp_timer_get_time();
+        processMessage(channel, message, companion);
+        const uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - started_us);
+        ingest_stats.processed++;
+        ingest_stats.process_us_total += elapsed_us;
+        if (elapsed_us > ingest_stats.process_us_max) ingest_stats.process_us_max = elapsed_us;
+    }
+}
+
+void PowerwallMQTTClient::processMessage(uint8_t channel, const char *message, bool is_companion) {
+    const PowerwallTopic pw_topic = channel < TOPIC_COUNT ? (PowerwallTopic)channel : TOPIC_UNKNOWN;
 
     // Handle EV connected topic first (accepts non-numeric values like "true", "on", etc.)
-    if (config.ev_enabled && config.ev_connected_topic.length() > 0 && topicStr == config.ev_connected_topic) {
+    if (channel == MQTT_INGEST_EV_CONNECTED) {
         bool connected = false;
         String msgStr = String(message);
         msgStr.toLowerCase();
@@ -330,83 +905,126 @@ void PowerwallMQTTClient::onMqttMessage(char* topic, char* payload, AsyncMqttCli
 
     // Check if conversion was successful
     if (endptr == message || *endptr != '\0') {
-        Serial.printf("✗ Failed to parse MQTT value from topic '%s': %s\n", topic, message);
+        ingest_stats.parse_errors++;
+        Serial.printf("✗ Failed to parse MQTT value for '%s': %s\n",
+                      pw_topic != TOPIC_UNKNOWN ? getPowerwallTopicSuffix(pw_topic) :
+                      channel >= MQTT_INGEST_EXTRA ? "extra node topic" : "EV topic", message);
         return;
     }
 
-    // Match topic and call appropriate callback
-    if (topicStr == prefix + "solar/instant_power") {
-        if (solarCallback) {
-            solarCallback(value);
-        }
-        Serial.printf("← MQTT: Solar: %.1f W\n", value);
-    }
-    else if (topicStr == prefix + "site/instant_power") {
-        if (gridCallback) {
-            gridCallback(value);
-        }
-        Serial.printf("← MQTT: Grid: %.1f W\n", value);
-    }
-    else if (topicStr == prefix + "load/instant_power") {
-        // Subtract EV power from home if EV tracking is enabled
-        float adjusted_home = value;
-        if (config.ev_enabled && last_ev_power > 0) {
-            adjusted_home = value - last_ev_power;
-            if (adjusted_home < 0) adjusted_home = 0;
-        }
-        if (homeCallback) {
-            homeCallback(adjusted_home);
-        }
-        if (config.ev_enabled && last_ev_power > 0) {
-            Serial.printf("← MQTT: Load: %.1f W (adjusted: %.1f W, EV: %.1f W)\n", value, adjusted_home, last_ev_power);
+    if (pw_topic != TOPIC_UNKNOWN) {
+        if (is_companion) {
+            bootstrap_stats.companion_applied++;
         } else {
-            Serial.printf("← MQTT: Load: %.1f W\n", value);
+            publishCompanion(pw_topic, message);
         }
-    }
-    else if (topicStr == prefix + "battery/instant_power") {
-        if (batteryCallback) {
-            batteryCallback(value);
+        filled_mask |= (1U << pw_topic);
+        if (bootstrap_stats.last_bootstrap_ms == 0 && (filled_mask & MQTT_BOOTSTRAP_MASK) == MQTT_BOOTSTRAP_MASK) {
+            bootstrap_stats.last_bootstrap_ms = millis() - connect_event_ms;
+            Serial.printf("✓ Dashboard complete %lu ms after MQTT connect\n", (unsigned long)bootstrap_stats.last_bootstrap_ms);
         }
-        Serial.printf("← MQTT: Battery: %.1f W\n", value);
     }
-    else if (topicStr == prefix + "battery/level") {
-        if (socCallback) {
-            socCallback(value);
-        }
-        Serial.printf("← MQTT: SOC: %.1f %%\n", value);
-    }
-    else if (topicStr == prefix + "site/offgrid") {
-        // Parse integer value with error checking
-        char* endptr_int;
-        long offgrid_long = strtol(message, &endptr_int, 10);
-        if (endptr_int == message || *endptr_int != '\0' || offgrid_long < 0 || offgrid_long > 1) {
-            Serial.printf("✗ Failed to parse off-grid value: %s\n", message);
+
+    // Dispatch by topic
+    switch (pw_topic) {
+        case TOPIC_SOLAR:
+            if (solarCallback) {
+                solarCallback(value);
+            }
+            Serial.printf("← MQTT: Solar: %.1f W\n", value);
+            return;
+        case TOPIC_GRID:
+            if (gridCallback) {
+                gridCallback(value);
+            }
+            Serial.printf("← MQTT: Grid: %.1f W\n", value);
+            return;
+        case TOPIC_HOME: {
+            // Subtract EV charger power (tracked EV and extra EV nodes) from home
+            const float ev_power = chargerPower();
+            float adjusted_home = value;
+            if (ev_power > 0) {
+                adjusted_home = value - ev_power;
+                if (adjusted_home < 0) adjusted_home = 0;
+            }
+            if (homeCallback) {
+                homeCallback(adjusted_home);
+            }
+            if (ev_power > 0) {
+                Serial.printf("← MQTT: Load: %.1f W (adjusted: %.1f W, EV: %.1f W)\n", value, adjusted_home, ev_power);
+            } else {
+                Serial.printf("← MQTT: Load: %.1f W\n", value);
+            }
             return;
         }
-        int offgrid = (int)offgrid_long;
-        if (offGridCallback) {
-            offGridCallback(offgrid);
-        }
-        Serial.printf("← MQTT: Off-grid: %d\n", offgrid);
-    }
-    else if (topicStr == prefix + "battery/time_remaining") {
-        if (timeRemainingCallback) {
-            timeRemainingCallback(value);
+        case TOPIC_BATTERY:
+            if (batteryCallback) {
+                batteryCallback(value);
+            }
+            Serial.printf("← MQTT: Battery: %.1f W\n", value);
+            return;
+        case TOPIC_SOC:
+            if (socCallback) {
+                socCallback(value);
+            }
+            Serial.printf("← MQTT: SOC: %.1f %%\n", value);
+            return;
+        case TOPIC_OFFGRID: {
+            // Parse integer value with error checking
+            char* endptr_int;
+            long offgrid_long = strtol(message, &endptr_int, 10);
+            if (endptr_int == message || *endptr_int != '\0' || offgrid_long < 0 || offgrid_long > 1) {
+                Serial.printf("✗ Failed to parse off-grid value: %s\n", message);
+                return;
+            }
+            int offgrid = (int)offgrid_long;
+            if (offGridCallback) {
+                offGridCallback(offgrid);
+            }
+            Serial.printf("← MQTT: Off-grid: %d\n", offgrid);
+            return;
         }
-        Serial.printf("← MQTT: Time remaining: %.1f hours\n", value);
+        case TOPIC_TIME_REMAINING:
+            if (timeRemainingCallback) {
+                timeRemainingCallback(value);
+            }
+            Serial.printf("← MQTT: Time remaining: %.1f hours\n", value);
+            return;
+        default:
+            break;
     }
+
     // EV topics (use full topic path matching, not prefix-based)
-    else if (config.ev_enabled && config.ev_power_topic.length() > 0 && topicStr == config.ev_power_topic) {
+    if (channel == MQTT_INGEST_EV_POWER) {
         last_ev_power = value;
         if (evCallback) {
             evCallback(value);
         }
         Serial.printf("← MQTT: EV Power: %.1f W\n", value);
     }
-    else if (config.ev_enabled && config.ev_soc_topic.length() > 0 && topicStr == config.ev_soc_topic) {
+    else if (channel == MQTT_INGEST_EV_SOC) {
         if (evSOCCallback) {
             evSOCCallback(value);
         }
         Serial.printf("← MQTT: EV SOC: %.1f %%\n", value);
     }
+    else if (channel >= MQTT_INGEST_EXTRA && channel < MQTT_INGEST_EXTRA + extra_node_count) {
+        const uint8_t index = channel - MQTT_INGEST_EXTRA;
+        extra_node_list[index].last_w = value;
+        if (extraNodeCallback) {
+            extraNodeCallback(index, value);
+        }
+        Serial.printf("← MQTT: Extra %s %d: %.1f W\n", getPowerNodeRoleName(extra_node_list[index].role), index + 1, value);
+    }
+}
+
+// Charger power included in the home reading
+float PowerwallMQTTClient::chargerPower() {
+    float total = (config.ev_enabled && last_ev_power > 0) ? last_ev_power : 0.0f;
+    for (uint8_t i = 0; i < extra_node_count; i++) {
+        if (extra_node_list[i].role == NODE_EV && extra_node_list[i].last_w > 0) {
+            total += extra_node_list[i].last_w;
+        }
+    }
+    return total;
 }
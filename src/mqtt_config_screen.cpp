@@ -1,4 +1,6 @@
 #include "mqtt_config_screen.h"
+#include "ui_styles.h"
+#include "lazy_screens.h"
 #include <lvgl.h>
 #include <cstdio>
 #include <cstring>
@@ -22,25 +24,20 @@ void createMqttConfigScreen(lv_obj_t *parent_screen) {
     mqtt_config_screen = lv_obj_create(parent_screen);
     lv_obj_set_size(mqtt_config_screen, 480, 480);
     lv_obj_set_pos(mqtt_config_screen, 0, 0);
-    lv_obj_set_style_bg_color(mqtt_config_screen, lv_color_hex(COLOR_BG), 0);
-    lv_obj_set_style_bg_opa(mqtt_config_screen, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_width(mqtt_config_screen, 0, 0);
-    lv_obj_set_style_radius(mqtt_config_screen, 0, 0);
+    lv_obj_add_style(mqtt_config_screen, &ui_style_overlay, 0);
     lv_obj_clear_flag(mqtt_config_screen, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_add_flag(mqtt_config_screen, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
 
     // Title
     lv_obj_t *title = lv_label_create(mqtt_config_screen);
     lv_label_set_text(title, "MQTT Not Configured");
-    lv_obj_set_style_text_color(title, lv_color_hex(COLOR_WHITE), 0);
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_24, 0);
+    lv_obj_add_style(title, &ui_style_title, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 40);
 
     // Instruction
     lv_obj_t *instruction = lv_label_create(mqtt_config_screen);
     lv_label_set_text(instruction, "Scan to configure");
-    lv_obj_set_style_text_color(instruction, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(instruction, &lv_font_montserrat_16, 0);
+    lv_obj_add_style(instruction, &ui_style_header, 0);
     lv_obj_align(instruction, LV_ALIGN_TOP_MID, 0, 75);
 
     // QR code (created but not populated yet - will be set when showing)
@@ -53,8 +50,8 @@ void createMqttConfigScreen(lv_obj_t *parent_screen) {
     // URL label (will be updated when showing)
     url_label = lv_label_create(mqtt_config_screen);
     lv_label_set_text(url_label, "");
+    lv_obj_add_style(url_label, &ui_style_url, 0);
     lv_obj_set_style_text_color(url_label, lv_color_hex(COLOR_ACCENT), 0);
-    lv_obj_set_style_text_font(url_label, &lv_font_montserrat_20, 0);
     lv_obj_align(url_label, LV_ALIGN_BOTTOM_MID, 0, -60);
 
     // Hint
@@ -65,7 +62,16 @@ void createMqttConfigScreen(lv_obj_t *parent_screen) {
     lv_obj_align(hint, LV_ALIGN_BOTTOM_MID, 0, -30);
 }
 
+void destroyMqttConfigScreen() {
+    if (!mqtt_config_screen) return;
+    lv_obj_del(mqtt_config_screen);
+    mqtt_config_screen = nullptr;
+    qr_code = nullptr;
+    url_label = nullptr;
+}
+
 void showMqttConfigScreen(const char* ip_address) {
+    ensureLazyScreen(LAZY_SCREEN_MQTT_CONFIG);
     if (mqtt_config_screen && qr_code && url_label) {
         // Build URL
         char url[64];
@@ -0,0 +1,55 @@
+#include "mqtt_topics.h"
+
+struct TopicEntry {
+    const char *suffix;
+    uint8_t length;
+};
+
+// Indexed by PowerwallTopic
+static const TopicEntry topic_table[TOPIC_COUNT] = {
+    { "solar/instant_power",    19 },
+    { "site/instant_power",     18 },
+    { "load/instant_power",     18 },
+    { "battery/instant_power",  21 },
+    { "battery/level",          13 },
+    { "site/offgrid",           12 },
+    { "battery/time_remaining", 22 },
+};
+
+const char* getPowerwallTopicSuffix(PowerwallTopic topic) {
+    return topic < TOPIC_COUNT ? topic_table[topic].suffix : "";
+}
+
+PowerwallTopic matchPowerwallTopic(const char *suffix) {
+    // Length and first character reject most unrelated topics before any compare
+    const size_t length = strlen(suffix);
+    for (uint8_t i = 0; i < TOPIC_COUNT; i++) {
+        const TopicEntry &entry = topic_table[i];
+        if (entry.length == length && entry.suffix[0] == suffix[0] &&
+            memcmp(entry.suffix, suffix, length) == 0) {
+            return (PowerwallTopic)i;
+        }
+    }
+    return TOPIC_UNKNOWN;
+}
+
+bool mqttTopicMatchesFilter(const char *filter, const char *topic) {
+    while (*filter) {
+        if (*filter == '#') {
+            return true;  // Matches the rest, including the parent level
+        }
+        if (*filter == '+') {
+            // One whole level
+            while (*topic && *topic != '/') topic++;
+            filter++;
+        } else {
+            if (*filter != *topic) {
+                // "a/#" also matches "a"
+                return *topic == '\0' && filter[0] == '/' && filter[1] == '#' && filter[2] == '\0';
+            }
+            filter++;
+            topic++;
+        }
+    }
+    return *topic == '\0';
+}
@@ -0,0 +1,99 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <WiFi.h>
+#include <stdarg.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+
+static unsigned long virtual_ms = 0;
+
+unsigned long millis() {
+    return virtual_ms;
+}
+
+unsigned long micros() {
+    return virtual_ms * 1000UL;
+}
+
+void delay(unsigned long ms) {
+    virtual_ms += ms;
+}
+
+void yield() {
+}
+
+void nativeAdvanceMillis(unsigned long ms) {
+    virtual_ms += ms;
+}
+
+size_t HardwareSerial::printf(const char *format, ...) {
+    if (quiet) return 0;
+    va_list args;
+    va_start(args, format);
+    const int written = vprintf(format, args);
+    va_end(args);
+    return written > 0 ? (size_t)written : 0;
+}
+
+void EspClass::restart() {
+    ::printf("ESP.restart() requested, exiting\n");
+    exit(0);
+}
+
+// Preferences
+
+static std::map<std::string, std::map<std::string, std::vector<uint8_t>>> nvs;
+
+bool Preferences::begin(const char *name, bool readOnly) {
+    space = &nvs[name];
+    read_only = readOnly;
+    return true;
+}
+
+bool Preferences::clear() {
+    if (!space || read_only) return false;
+    space->clear();
+    return true;
+}
+
+bool Preferences::remove(const char *key) {
+    if (!space || read_only) return false;
+    return space->erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) const {
+    return find(key) != nullptr;
+}
+
+size_t Preferences::put(const char *key, const void *value, size_t len) {
+    if (!space || read_only) return 0;
+    const uint8_t *bytes = (const uint8_t *)value;
+    (*space)[key].assign(bytes, bytes + len);
+    return len;
+}
+
+const std::vector<uint8_t> *Preferences::find(const char *key) const {
+    if (!space) return nullptr;
+    auto it = space->find(key);
+    return it == space->end() ? nullptr : &it->second;
+}
+
+String Preferences::getString(const char *key, const String def) const {
+    const std::vector<uint8_t> *value = find(key);
+    if (!value || value->empty()) return def;
+    return String((const char *)value->data());
+}
+
+size_t Preferences::getBytesLength(const char *key) const {
+    const std::vector<uint8_t> *value = find(key);
+    return value ? value->size() : 0;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) const {
+    const std::vector<uint8_t> *value = find(key);
+    if (!value || value->size() > maxLen) return 0;
+    memcpy(buf, value->data(), value->size());
+    return value->size();
+}
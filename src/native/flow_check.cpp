@@ -0,0 +1,157 @@
+#include "flow_check.h"
+#include "power_flow.h"
+#include <esp_timer.h>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+// Relative tolerance for float sums
+#define FLOW_EPSILON 1e-4f
+
+static uint32_t rng_state = 0x2545F491;
+
+static uint32_t nextRandom() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static float randomWatts(float range) {
+    const uint32_t r = nextRandom();
+    const float unit = (r & 0xFFFFFF) / (float)0xFFFFFF;  // 0..1
+    // A quarter of the values are exactly zero, like idle sources
+    return (r >> 30) == 0 ? 0.0f : (unit * 2.0f - 1.0f) * range;
+}
+
+// The standard dashboard nodes plus a random mix of generators, batteries and EV chargers
+static PowerTopology randomTopology() {
+    PowerTopology t = {};
+    addPowerNode(t, NODE_SOLAR);
+    addPowerNode(t, NODE_GRID);
+    const uint8_t home = addPowerNode(t, NODE_HOME);
+    addPowerNode(t, NODE_BATTERY);
+    const uint32_t extras = nextRandom() % (POWER_FLOW_MAX_NODES - 3);
+    for (uint32_t i = 0; i < extras; i++) {
+        static const PowerNodeRole extra_roles[] = { NODE_GENERATOR, NODE_BATTERY, NODE_EV, NODE_SOLAR };
+        const PowerNodeRole role = extra_roles[nextRandom() % 4];
+        addPowerNode(t, role, role == NODE_EV ? home : POWER_NODE_NONE);
+    }
+
+    for (uint8_t i = 0; i < t.count; i++) {
+        PowerNode &node = t.nodes[i];
+        const bool bidirectional = node.role == NODE_GRID || node.role == NODE_BATTERY;
+        node.w = bidirectional ? randomWatts(12000.0f) : fabsf(randomWatts(12000.0f));
+        node.soc = fabsf(randomWatts(100.0f));
+    }
+    return t;
+}
+
+static uint32_t checkTopology(const PowerTopology &t) {
+    PowerFlowResult r;
+    solvePowerFlows(t, r);
+    uint32_t violations = 0;
+    auto expect = [&](bool ok, const char *what) {
+        if (ok) return;
+        if (violations++ == 0) {
+            printf("flow check failed (%s):", what);
+            for (uint8_t i = 0; i < t.count; i++) {
+                printf(" %s=%.1f", getPowerNodeRoleName(t.nodes[i].role), t.nodes[i].w);
+            }
+            printf("\n");
+        }
+    };
+
+    float supply[POWER_FLOW_MAX_NODES], demand[POWER_FLOW_MAX_NODES];
+    float scale = 1.0f;
+    for (uint8_t i = 0; i < t.count; i++) {
+        const PowerNode &node = t.nodes[i];
+        const float w = node.w;
+        const bool source = node.role != NODE_HOME && node.role != NODE_EV;
+        const bool sink = node.role == NODE_GRID || node.role == NODE_BATTERY || node.role == NODE_HOME;
+        supply[i] = source && w > 0 ? w : 0.0f;
+        demand[i] = sink ? (node.role == NODE_HOME ? fmaxf(w, 0.0f) : fmaxf(-w, 0.0f)) : 0.0f;
+        scale += fabsf(w);
+    }
+    const float eps = FLOW_EPSILON * scale;
+
+    float max_active = 0.0f;
+    for (uint8_t e = 0; e < r.count; e++) {
+        const PowerFlow &f = r.flows[e];
+        expect(f.from < t.count && f.to < t.count && f.from != f.to, "edge nodes");
+        expect(f.w > 0.0f && isfinite(f.w), "positive");
+        if (isPowerFlowActive(f.w) && f.w > max_active) max_active = f.w;
+
+        const PowerNode &from = t.nodes[f.from];
+        const PowerNode &to = t.nodes[f.to];
+        if (to.role == NODE_EV) {
+            expect(to.feeder == f.from && f.w == to.w, "ev edge");
+            continue;
+        }
+        expect(canPowerFlow(from.role, to.role), "allowed roles");
+        if (from.role == NODE_SOLAR && to.role == NODE_BATTERY) {
+            expect(to.soc < POWER_FLOW_BATTERY_FULL_SOC, "full battery charged by solar");
+        }
+        supply[f.from] -= f.w;
+        demand[f.to] -= f.w;
+    }
+    expect(r.max_active == max_active, "max_active");
+
+    // Per-node bounds and maximality
+    for (uint8_t i = 0; i < t.count; i++) {
+        expect(supply[i] >= -eps, "source bound");
+        expect(demand[i] >= -eps, "sink bound");
+    }
+    for (uint8_t i = 0; i < t.count; i++) {
+        if (supply[i] <= eps) continue;
+        for (uint8_t j = 0; j < t.count; j++) {
+            if (i == j || demand[j] <= eps || !canPowerFlow(t.nodes[i].role, t.nodes[j].role)) continue;
+            if (t.nodes[i].role == NODE_SOLAR && t.nodes[j].role == NODE_BATTERY &&
+                t.nodes[j].soc >= POWER_FLOW_BATTERY_FULL_SOC) {
+                continue;
+            }
+            expect(false, "unmatched supply and demand");
+        }
+    }
+
+    uint8_t ev_edges = 0, ev_expected = 0;
+    for (uint8_t e = 0; e < r.count; e++) ev_edges += t.nodes[r.flows[e].to].role == NODE_EV;
+    for (uint8_t i = 0; i < t.count; i++) {
+        ev_expected += t.nodes[i].role == NODE_EV && t.nodes[i].w > POWER_FLOW_THRESHOLD_W;
+    }
+    expect(ev_edges == ev_expected, "ev edge count");
+    return violations;
+}
+
+uint32_t runPowerFlowChecks(uint32_t iterations) {
+    std::vector<PowerTopology> topologies(iterations);
+    for (PowerTopology &t : topologies) t = randomTopology();
+
+    uint32_t violations = 0;
+    uint32_t failed = 0;
+    uint64_t nodes = 0;
+    for (const PowerTopology &t : topologies) {
+        const uint32_t v = checkTopology(t);
+        violations += v;
+        if (v) failed++;
+        nodes += t.count;
+    }
+    printf("Power flow properties: %u topologies (avg %.1f nodes), %u failed (%u violations)\n",
+           iterations, iterations ? (double)nodes / iterations : 0.0, failed, violations);
+
+    // Microbenchmark; the checksum keeps the calls from being optimized out
+    const int passes = 20;
+    volatile float checksum = 0.0f;
+    PowerFlowResult result;
+    const int64_t started_us = esp_timer_get_time();
+    for (int pass = 0; pass < passes; pass++) {
+        for (const PowerTopology &t : topologies) {
+            solvePowerFlows(t, result);
+            checksum = checksum + result.max_active;
+        }
+    }
+    const int64_t elapsed_us = esp_timer_get_time() - started_us;
+    const double calls = (double)passes * iterations;
+    printf("solvePowerFlows: %.1f ns/call over %.0f calls\n", calls ? elapsed_us * 1000.0 / calls : 0.0, calls);
+    return violations;
+}
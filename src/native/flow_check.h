@@ -0,0 +1,13 @@
+#ifndef FLOW_CHECK_H
+#define FLOW_CHECK_H
+
+#include <stdint.h>
+
+// Property checks and a microbenchmark for solvePowerFlows() over random
+// topologies and readings (fixed seed): flows are positive and only run
+// between roles that may connect, no node sends more than it produces or
+// receives more than it consumes, and no source/sink pair that could still
+// be matched is left over. Returns the number of violations.
+uint32_t runPowerFlowChecks(uint32_t iterations);
+
+#endif // FLOW_CHECK_H
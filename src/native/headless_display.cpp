@@ -0,0 +1,64 @@
+#include "headless_display.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+
+static uint16_t framebuffer[HEADLESS_WIDTH * HEADLESS_HEIGHT];
+static lv_color_t *draw_buf1 = nullptr;
+static lv_color_t *draw_buf2 = nullptr;
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static HeadlessDisplayStats stats = {};
+
+static void headless_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
+    const int32_t w = area->x2 - area->x1 + 1;
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&framebuffer[y * HEADLESS_WIDTH + area->x1], color_p, w * sizeof(uint16_t));
+        color_p += w;
+    }
+    stats.flushes++;
+    stats.flushed_pixels += (uint32_t)(w * (area->y2 - area->y1 + 1));
+    lv_disp_flush_ready(disp);
+}
+
+void setupHeadlessDisplay() {
+    const size_t buf_size = HEADLESS_WIDTH * HEADLESS_HEIGHT;
+    draw_buf1 = (lv_color_t *)malloc(sizeof(lv_color_t) * buf_size);
+    draw_buf2 = (lv_color_t *)malloc(sizeof(lv_color_t) * buf_size);
+    lv_disp_draw_buf_init(&draw_buf, draw_buf1, draw_buf2, buf_size);
+
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = HEADLESS_WIDTH;
+    disp_drv.ver_res = HEADLESS_HEIGHT;
+    disp_drv.flush_cb = headless_flush;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.full_refresh = 1;  // Same as the device
+    lv_disp_drv_register(&disp_drv);
+}
+
+const uint16_t* getHeadlessFramebuffer() {
+    return framebuffer;
+}
+
+static uint32_t timed(void (*fn)()) {
+    const int64_t started_us = esp_timer_get_time();
+    const uint32_t flushes_before = stats.flushes;
+    fn();
+    if (stats.flushes == flushes_before) return 0;  // Nothing was drawn
+
+    const uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - started_us);
+    stats.render_us_total += elapsed_us;
+    if (elapsed_us > stats.render_us_max) stats.render_us_max = elapsed_us;
+    return elapsed_us;
+}
+
+uint32_t runHeadlessTimers() {
+    return timed([]() { lv_timer_handler(); });
+}
+
+uint32_t renderHeadlessFrame() {
+    return timed([]() { lv_refr_now(NULL); });
+}
+
+const HeadlessDisplayStats& getHeadlessDisplayStats() {
+    return stats;
+}
@@ -0,0 +1,31 @@
+#ifndef HEADLESS_DISPLAY_H
+#define HEADLESS_DISPLAY_H
+
+#include <lvgl.h>
+
+// LVGL display driver for the native build: full-frame refresh (as on the
+// device) into an RGB565 framebuffer in memory
+
+#define HEADLESS_WIDTH 480
+#define HEADLESS_HEIGHT 480
+
+struct HeadlessDisplayStats {
+    uint32_t flushes;
+    uint32_t flushed_pixels;
+    uint64_t render_us_total;  // Time spent inside lv_timer_handler()/lv_refr_now()
+    uint32_t render_us_max;
+};
+
+void setupHeadlessDisplay();
+
+// Last flushed frame, HEADLESS_WIDTH * HEADLESS_HEIGHT RGB565 pixels
+const uint16_t* getHeadlessFramebuffer();
+
+// Run LVGL timers (and any due refresh) / force a full redraw. Both return
+// the render time in us, 0 if nothing was drawn.
+uint32_t runHeadlessTimers();
+uint32_t renderHeadlessFrame();
+
+const HeadlessDisplayStats& getHeadlessDisplayStats();
+
+#endif // HEADLESS_DISPLAY_H
@@ -0,0 +1,72 @@
+#include "lvgl_heap.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Host replacement for the multi_heap pools: plain malloc with a size header,
+// reporting the same stats against the device's pool sizes so heap growth
+// shows up in native runs.
+
+#define LVGL_HEAP_TOTAL (LVGL_HEAP_PSRAM_SIZE + LVGL_HEAP_FAST_SIZE)
+
+struct AllocHeader {
+    size_t size;
+    size_t pad;  // Keeps the payload 16-byte aligned
+};
+
+static size_t used_bytes = 0;
+static size_t peak_used_bytes = 0;
+static uint32_t alloc_count = 0;
+static uint32_t fast_alloc_count = 0;
+static uint32_t overflow_count = 0;
+static uint32_t failure_count = 0;
+
+void *lvgl_heap_alloc(size_t size) {
+    if (size == 0) return nullptr;
+    AllocHeader *header = (AllocHeader *)malloc(sizeof(AllocHeader) + size);
+    if (!header) {
+        failure_count++;
+        return nullptr;
+    }
+    header->size = size;
+    alloc_count++;
+    if (size <= LVGL_HEAP_FAST_MAX) fast_alloc_count++;
+    used_bytes += size;
+    if (used_bytes > LVGL_HEAP_TOTAL) overflow_count++;
+    if (used_bytes > peak_used_bytes) peak_used_bytes = used_bytes;
+    return header + 1;
+}
+
+void lvgl_heap_free(void *ptr) {
+    if (!ptr) return;
+    AllocHeader *header = (AllocHeader *)ptr - 1;
+    used_bytes -= header->size;
+    free(header);
+}
+
+void *lvgl_heap_realloc(void *ptr, size_t new_size) {
+    if (!ptr) return lvgl_heap_alloc(new_size);
+    if (new_size == 0) {
+        lvgl_heap_free(ptr);
+        return nullptr;
+    }
+    void *moved = lvgl_heap_alloc(new_size);
+    if (!moved) return nullptr;
+    const size_t old_size = ((AllocHeader *)ptr - 1)->size;
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    lvgl_heap_free(ptr);
+    return moved;
+}
+
+void lvgl_heap_get_stats(lvgl_heap_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    const size_t free_bytes = used_bytes < LVGL_HEAP_TOTAL ? LVGL_HEAP_TOTAL - used_bytes : 0;
+    stats->total_bytes = LVGL_HEAP_TOTAL;
+    stats->used_bytes = (uint32_t)used_bytes;
+    stats->free_bytes = (uint32_t)free_bytes;
+    stats->largest_free_block = (uint32_t)free_bytes;
+    stats->min_free_bytes = peak_used_bytes < LVGL_HEAP_TOTAL ? (uint32_t)(LVGL_HEAP_TOTAL - peak_used_bytes) : 0;
+    stats->alloc_count = alloc_count;
+    stats->fast_alloc_count = fast_alloc_count;
+    stats->overflow_count = overflow_count;
+    stats->failure_count = failure_count;
+}
@@ -0,0 +1,201 @@
+// Headless dashboard for the host (pio run -e native). LVGL renders into an
+// in-memory framebuffer while synthetic pypowerwall traffic goes through the
+// real MQTT client, so the parse/dispatch/UI path can be benchmarked and
+// profiled (perf, valgrind) without flashing hardware.
+//
+//   .pio/build/native/program [--frames N] [--frame-ms MS] [--msgs-per-frame N]
+//                             [--max-rate MSG/S] [--dimmed] [--verbose]
+//   .pio/build/native/program --scenes DIR [--scene-frames N]   (golden images)
+//   .pio/build/native/program --flows N                         (flow allocation checks)
+
+#include <Arduino.h>
+#include <AsyncMqttClient.h>
+#include <Preferences.h>
+#include <lvgl.h>
+#include <esp_timer.h>
+#include <algorithm>
+#include <vector>
+#include "headless_display.h"
+#include "render_scenes.h"
+#include "flow_check.h"
+#include "mqtt_client.h"
+#include "mqtt_topics.h"
+#include "main_screen.h"
+#include "lazy_screens.h"
+#include "ui_screens.h"
+#include "boot_timeline.h"
+#include "metrics_store.h"
+#include "lvgl_heap.h"
+
+#define NATIVE_TOPIC_PREFIX "pypowerwall/"
+
+struct BenchOptions {
+    uint32_t frames = 600;
+    uint32_t frame_ms = 33;
+    uint32_t msgs_per_frame = TOPIC_COUNT;
+    int32_t max_rate = 0;  // Unlimited, measure the whole pipeline
+    bool verbose = false;
+    bool dimmed = false;  // Backlight dimmed: reduced animation rate
+    const char *scenes_dir = nullptr;
+    uint32_t scene_frames = 30;
+    uint32_t flow_checks = 0;
+};
+
+static void usage(const char *program) {
+    printf("Usage: %s [--frames N] [--frame-ms MS] [--msgs-per-frame N] [--max-rate MSG/S] [--dimmed] [--verbose]\n"
+           "       %s --scenes DIR [--scene-frames N]\n"
+           "       %s --flows N\n",
+           program, program, program);
+    exit(1);
+}
+
+static BenchOptions parseOptions(int argc, char **argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && has_value) {
+            options.frames = (uint32_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--frame-ms") == 0 && has_value) {
+            options.frame_ms = max(1L, atol(argv[++i]));
+        } else if (strcmp(argv[i], "--msgs-per-frame") == 0 && has_value) {
+            options.msgs_per_frame = (uint32_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--max-rate") == 0 && has_value) {
+            options.max_rate = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--scenes") == 0 && has_value) {
+            options.scenes_dir = argv[++i];
+        } else if (strcmp(argv[i], "--scene-frames") == 0 && has_value) {
+            options.scene_frames = (uint32_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--flows") == 0 && has_value) {
+            options.flow_checks = (uint32_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--dimmed") == 0) {
+            options.dimmed = true;
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            options.verbose = true;
+        } else {
+            usage(argv[0]);
+        }
+    }
+    return options;
+}
+
+// Plausible values that change over time (same shapes as tools/mqtt_trace.py)
+static void formatSyntheticValue(PowerwallTopic topic, float t, char *buf, size_t len) {
+    const float solar = max(0.0f, 6000.0f * sinf(t / 60.0f));
+    const float load = 1500.0f + 800.0f * sinf(t / 7.0f);
+    const float battery = (load - solar) * 0.6f;
+    float value = 0;
+    switch (topic) {
+        case TOPIC_SOLAR:          value = solar; break;
+        case TOPIC_GRID:           value = load - solar - battery; break;
+        case TOPIC_HOME:           value = load; break;
+        case TOPIC_BATTERY:        value = battery; break;
+        case TOPIC_SOC:            value = 50.0f + 40.0f * sinf(t / 300.0f); break;
+        case TOPIC_OFFGRID:        snprintf(buf, len, "0"); return;
+        case TOPIC_TIME_REMAINING: value = 12.5f; break;
+        default: break;
+    }
+    snprintf(buf, len, "%.1f", value);
+}
+
+static void setupMqtt(const BenchOptions &options) {
+    Preferences prefs;
+    prefs.begin("mqtt", false);
+    prefs.putString("host", "127.0.0.1");
+    prefs.putString("prefix", NATIVE_TOPIC_PREFIX);
+    prefs.putUShort("max_rate", (uint16_t)options.max_rate);
+    prefs.end();
+
+    mqttClient.setSolarCallback([](float w) { recordMetric(METRIC_SOLAR, w); updateSolarValue(w); });
+    mqttClient.setGridCallback([](float w) { recordMetric(METRIC_GRID, w); updateGridValue(w); });
+    mqttClient.setHomeCallback([](float w) { recordMetric(METRIC_HOME, w); updateHomeValue(w); });
+    mqttClient.setBatteryCallback([](float w) { recordMetric(METRIC_BATTERY, w); updateBatteryValue(w); });
+    mqttClient.setSOCCallback([](float soc) { recordMetric(METRIC_SOC, soc); updateSOC(soc); });
+    mqttClient.setOffGridCallback([](int offgrid) { recordMetric(METRIC_OFFGRID, offgrid); updateOffGridStatus(offgrid); });
+    mqttClient.setTimeRemainingCallback([](float h) { recordMetric(METRIC_TIME_REMAINING, h); updateTimeRemaining(h); });
+    mqttClient.begin();
+}
+
+static uint32_t percentile(std::vector<uint32_t> values, uint32_t pct) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, values.size() * pct / 100)];
+}
+
+int main(int argc, char **argv) {
+    const BenchOptions options = parseOptions(argc, argv);
+    if (options.flow_checks) {
+        return runPowerFlowChecks(options.flow_checks) == 0 ? 0 : 1;
+    }
+
+    setupMqtt(options);
+
+    lv_init();
+    setupHeadlessDisplay();
+    createScreens();
+    renderHeadlessFrame();
+    markBootFirstFrame();
+
+    if (options.scenes_dir) {
+        Serial.quiet = !options.verbose;
+        return runRenderScenes(options.scenes_dir, options.scene_frames) == 0 ? 0 : 1;
+    }
+
+    setDashboardDimmed(options.dimmed);
+    mqttClient.connect();
+    mqttClient.loop();  // Handle the connect event and subscribe
+    AsyncMqttClient *broker = AsyncMqttClient::nativeInstance();
+
+    Serial.quiet = !options.verbose;
+
+    std::vector<uint32_t> frame_us;
+    frame_us.reserve(options.frames);
+    uint32_t next_topic = 0;
+    const int64_t started_us = esp_timer_get_time();
+
+    for (uint32_t frame = 0; frame < options.frames; frame++) {
+        nativeAdvanceMillis(options.frame_ms);
+        lv_tick_inc(options.frame_ms);
+
+        const float t = millis() / 1000.0f;
+        for (uint32_t i = 0; i < options.msgs_per_frame; i++) {
+            const PowerwallTopic topic = (PowerwallTopic)(next_topic++ % TOPIC_COUNT);
+            char topic_buf[64];
+            char payload[16];
+            snprintf(topic_buf, sizeof(topic_buf), NATIVE_TOPIC_PREFIX "%s", getPowerwallTopicSuffix(topic));
+            formatSyntheticValue(topic, t, payload, sizeof(payload));
+            broker->nativeInjectMessage(topic_buf, payload);
+        }
+
+        const int64_t frame_start = esp_timer_get_time();
+        mqttClient.loop();
+        updateDataRxPulse();
+        updatePowerFlowAnimation();
+        loopMetricsStore();
+        runHeadlessTimers();
+        updateLazyScreens();
+        frame_us.push_back((uint32_t)(esp_timer_get_time() - frame_start));
+    }
+
+    const double wall_ms = (esp_timer_get_time() - started_us) / 1000.0;
+    Serial.quiet = false;
+
+    const HeadlessDisplayStats &display = getHeadlessDisplayStats();
+    const MQTTIngestStats &ingest = mqttClient.getIngestStats();
+    lvgl_heap_stats_t heap;
+    lvgl_heap_get_stats(&heap);
+
+    printf("\nFrames: %u x %u ms virtual, %.1f ms wall\n", options.frames, options.frame_ms, wall_ms);
+    uint64_t frame_us_total = 0;
+    for (uint32_t us : frame_us) frame_us_total += us;
+    printf("Loop pass us: avg %.1f, p50 %u, p99 %u, max %u\n",
+           frame_us.empty() ? 0.0 : (double)frame_us_total / frame_us.size(),
+           percentile(frame_us, 50), percentile(frame_us, 99), percentile(frame_us, 100));
+    printf("Render: %u flushes, avg %.1f us, max %u us\n", display.flushes,
+           display.flushes ? (double)display.render_us_total / display.flushes : 0.0, display.render_us_max);
+    printf("MQTT ingest: received %u, processed %u, coalesced %u, ignored %u, parse errors %u, "
+           "process avg %.1f us, max %u us\n",
+           ingest.received, ingest.processed, ingest.coalesced, ingest.ignored, ingest.parse_errors,
+           ingest.processed ? (double)ingest.process_us_total / ingest.processed : 0.0, ingest.process_us_max);
+    printf("LVGL heap: %u used, %u min free, %u allocs\n", heap.used_bytes, heap.min_free_bytes, heap.alloc_count);
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "png_writer.h"
+#include <esp_rom_crc.h>
+#include <stdio.h>
+#include <vector>
+
+// Largest stored deflate block
+#define DEFLATE_STORED_MAX 65535
+
+static void putBE32(std::vector<uint8_t> &out, uint32_t v) {
+    out.push_back((uint8_t)(v >> 24));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)v);
+}
+
+static void writeChunk(FILE *file, const char *type, const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> chunk;
+    putBE32(chunk, (uint32_t)data.size());
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    const uint32_t crc = esp_rom_crc32_le(0, chunk.data() + 4, (uint32_t)(chunk.size() - 4));
+    putBE32(chunk, crc);
+    fwrite(chunk.data(), 1, chunk.size(), file);
+}
+
+bool writePngRgb565(const char *path, const uint16_t *pixels, int width, int height) {
+    // Raw scanlines: filter byte 0, then RGB888
+    std::vector<uint8_t> raw;
+    raw.reserve((size_t)height * (width * 3 + 1));
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        for (int x = 0; x < width; x++) {
+            const uint16_t c = pixels[y * width + x];
+            const uint8_t r = (c >> 11) & 0x1F;
+            const uint8_t g = (c >> 5) & 0x3F;
+            const uint8_t b = c & 0x1F;
+            raw.push_back((uint8_t)((r << 3) | (r >> 2)));
+            raw.push_back((uint8_t)((g << 2) | (g >> 4)));
+            raw.push_back((uint8_t)((b << 3) | (b >> 2)));
+        }
+    }
+
+    // zlib stream of stored blocks
+    std::vector<uint8_t> idat = {0x78, 0x01};
+    uint32_t adler_a = 1, adler_b = 0;
+    for (size_t pos = 0; pos < raw.size(); pos += DEFLATE_STORED_MAX) {
+        const size_t len = raw.size() - pos < DEFLATE_STORED_MAX ? raw.size() - pos : DEFLATE_STORED_MAX;
+        idat.push_back(pos + len == raw.size() ? 1 : 0);  // BFINAL, BTYPE=00
+        idat.push_back((uint8_t)len);
+        idat.push_back((uint8_t)(len >> 8));
+        idat.push_back((uint8_t)~len);
+        idat.push_back((uint8_t)(~len >> 8));
+        idat.insert(idat.end(), raw.begin() + pos, raw.begin() + pos + len);
+        for (size_t i = pos; i < pos + len; i++) {
+            adler_a = (adler_a + raw[i]) % 65521;
+            adler_b = (adler_b + adler_a) % 65521;
+        }
+    }
+    putBE32(idat, (adler_b << 16) | adler_a);
+
+    std::vector<uint8_t> ihdr;
+    putBE32(ihdr, (uint32_t)width);
+    putBE32(ihdr, (uint32_t)height);
+    ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0});  // 8-bit RGB, no interlace
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    fwrite(signature, 1, sizeof(signature), file);
+    writeChunk(file, "IHDR", ihdr);
+    writeChunk(file, "IDAT", idat);
+    writeChunk(file, "IEND", {});
+    return fclose(file) == 0;
+}
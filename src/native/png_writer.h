@@ -0,0 +1,9 @@
+#ifndef PNG_WRITER_H
+#define PNG_WRITER_H
+
+#include <stdint.h>
+
+// Write an RGB565 framebuffer as a 24-bit PNG (stored deflate blocks, no zlib)
+bool writePngRgb565(const char *path, const uint16_t *pixels, int width, int height);
+
+#endif // PNG_WRITER_H
@@ -0,0 +1,118 @@
+#include "render_scenes.h"
+#include "headless_display.h"
+#include "png_writer.h"
+#include "main_screen.h"
+#include <Arduino.h>
+#include <lvgl.h>
+#include <algorithm>
+#include <vector>
+
+// Virtual time per settle frame (animation throttle is ~30 FPS)
+#define SCENE_FRAME_MS 33
+// Forced full redraws timed per scene
+#define SCENE_TIMING_RUNS 15
+
+struct RenderScene {
+    const char *name;
+    bool has_data;       // false: dashboard as it is before any MQTT value
+    bool ev_enabled;
+    float solar;
+    float grid;          // Positive = import
+    float home;
+    float battery;       // Positive = discharge
+    float soc;
+    int offgrid;
+    float time_remaining;
+    float ev_power;
+    bool ev_connected;
+    float ev_soc;
+    float generator;     // Extra nodes: a generator and a second charger,
+    float ev2;           // configured when either is non-zero
+};
+
+static const RenderScene scenes[] = {
+    // name            data   ev     solar   grid    home    batt    soc    off  hours  ev_w    ev_conn ev_soc gen    ev2
+    { "zero_data",     false, false, 0,      0,      0,      0,      0,     0,   0,     0,      false,  0,     0,     0 },
+    { "solar_export",  true,  false, 6200,   -3000,  1400,   -1800,  72,    0,   0,     0,      false,  0,     0,     0 },
+    { "off_grid",      true,  false, 800,    0,      1900,   1100,   48,    1,   9.5f,  0,      false,  0,     0,     0 },
+    { "ev_charging",   true,  true,  3500,   4200,   500,    0,      90,    0,   0,     7200,   true,   64,    0,     0 },
+    { "battery_full",  true,  false, 4000,   -2800,  1200,   0,      100,   0,   0,     0,      false,  0,     0,     0 },
+    { "multi_node",    true,  true,  1200,   0,      1500,   -2600,  40,    1,   0,     3600,   true,   30,    5000,  2500 },
+};
+
+static void applyScene(const RenderScene &scene) {
+    static const PowerNodeRole extra_roles[] = { NODE_GENERATOR, NODE_EV };
+    const bool extras = scene.generator != 0 || scene.ev2 != 0;
+    setEVEnabled(scene.ev_enabled);
+    configureExtraNodes(extra_roles, extras ? 2 : 0);
+    if (!scene.has_data) return;
+
+    updateSolarValue(scene.solar);
+    updateGridValue(scene.grid);
+    updateHomeValue(scene.home);
+    updateBatteryValue(scene.battery);
+    updateSOC(scene.soc);
+    updateOffGridStatus(scene.offgrid);
+    updateTimeRemaining(scene.time_remaining);
+    if (scene.ev_enabled) {
+        updateEVValue(scene.ev_power);
+        updateEVConnected(scene.ev_connected);
+        updateEVSOC(scene.ev_soc);
+    }
+    if (extras) {
+        updateExtraNodeValue(0, scene.generator);
+        updateExtraNodeValue(1, scene.ev2);
+    }
+}
+
+static uint32_t timeFullRedraw() {
+    std::vector<uint32_t> runs;
+    for (int i = 0; i < SCENE_TIMING_RUNS; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        runs.push_back(renderHeadlessFrame());
+    }
+    std::sort(runs.begin(), runs.end());
+    return runs[runs.size() / 2];
+}
+
+int runRenderScenes(const char *out_dir, uint32_t frames_per_scene) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/timings.json", out_dir);
+    FILE *timings = fopen(path, "w");
+    if (!timings) {
+        printf("Cannot write %s\n", path);
+        return (int)(sizeof(scenes) / sizeof(scenes[0]));
+    }
+    fprintf(timings, "{\n");
+
+    int failures = 0;
+    const size_t count = sizeof(scenes) / sizeof(scenes[0]);
+    for (size_t i = 0; i < count; i++) {
+        const RenderScene &scene = scenes[i];
+        applyScene(scene);
+
+        // Let the flow dots and the RX pulse settle at a fixed virtual time
+        uint32_t frame_us_max = 0;
+        for (uint32_t frame = 0; frame < frames_per_scene; frame++) {
+            nativeAdvanceMillis(SCENE_FRAME_MS);
+            lv_tick_inc(SCENE_FRAME_MS);
+            updateDataRxPulse();
+            updatePowerFlowAnimation();
+            frame_us_max = max(frame_us_max, runHeadlessTimers());
+        }
+
+        const uint32_t render_us = timeFullRedraw();
+        snprintf(path, sizeof(path), "%s/%s.png", out_dir, scene.name);
+        const bool written = writePngRgb565(path, getHeadlessFramebuffer(), HEADLESS_WIDTH, HEADLESS_HEIGHT);
+        if (!written) failures++;
+
+        printf("scene %-14s render %6u us (settle max %6u us)%s\n", scene.name, render_us, frame_us_max,
+               written ? "" : "  WRITE FAILED");
+        fprintf(timings, "  \"%s\": {\"render_us\": %u, \"settle_max_us\": %u}%s\n",
+                scene.name, render_us, frame_us_max, i + 1 < count ? "," : "");
+    }
+
+    fprintf(timings, "}\n");
+    fclose(timings);
+    return failures;
+}
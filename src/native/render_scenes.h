@@ -0,0 +1,14 @@
+#ifndef RENDER_SCENES_H
+#define RENDER_SCENES_H
+
+#include <stdint.h>
+
+// Golden-image scenes for tools/render_regression.py: drives the dashboard
+// through fixed metric sets, writes <out_dir>/<scene>.png and
+// <out_dir>/timings.json. Scenes run in order on one dashboard, so the
+// whole set is deterministic; regenerate the goldens together.
+//
+// Returns the number of scenes that failed to write.
+int runRenderScenes(const char *out_dir, uint32_t frames_per_scene);
+
+#endif // RENDER_SCENES_H
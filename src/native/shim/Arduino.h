@@ -0,0 +1,78 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+// Host (native) stand-in for the parts of the Arduino core the dashboard,
+// MQTT client and screens use. Time is a virtual clock so benchmark and
+// render runs are deterministic; advance it with nativeAdvanceMillis().
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include "WString.h"
+#include "IPAddress.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+
+#define PROGMEM
+
+using std::min;
+using std::max;
+
+// glibc only has strlcpy from 2.38 on (macOS always has it)
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+    const size_t len = strlen(src);
+    if (size > 0) {
+        const size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+// Native only: move the virtual clock forward
+void nativeAdvanceMillis(unsigned long ms);
+
+// FreeRTOS spinlocks; the native build is single-threaded
+typedef struct { int owner; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+class HardwareSerial {
+public:
+    void begin(unsigned long) {}
+    size_t print(const char *s) { return quiet ? 0 : fputs(s, stdout); }
+    size_t print(const String &s) { return print(s.c_str()); }
+    size_t println(const char *s = "") { return quiet ? 0 : printf("%s\n", s); }
+    size_t println(const String &s) { return println(s.c_str()); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    // Native only: silence firmware logging during benchmarks
+    bool quiet = false;
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    void restart();
+    uint64_t getEfuseMac() { return 0x0000DEADBEEF1234ULL; }
+    uint32_t getFreeHeap() { return 0; }
+    uint32_t getPsramSize() { return 0; }
+};
+extern EspClass ESP;
+
+inline bool psramFound() { return false; }
+
+#endif // NATIVE_ARDUINO_H
@@ -0,0 +1,101 @@
+#ifndef NATIVE_ASYNC_MQTT_CLIENT_H
+#define NATIVE_ASYNC_MQTT_CLIENT_H
+
+// Loopback AsyncMqttClient: connect() succeeds at once and messages are fed
+// in with nativeInjectMessage(), which goes through the same onMessage path
+// the TCP task uses on the device.
+
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+enum class AsyncMqttClientDisconnectReason : uint8_t {
+    TCP_DISCONNECTED = 0,
+    MQTT_UNACCEPTABLE_PROTOCOL_VERSION = 1,
+    MQTT_IDENTIFIER_REJECTED = 2,
+    MQTT_SERVER_UNAVAILABLE = 3,
+    MQTT_MALFORMED_CREDENTIALS = 4,
+    MQTT_NOT_AUTHORIZED = 5,
+    ESP8266_NOT_ENOUGH_SPACE = 6,
+    TLS_BAD_FINGERPRINT = 7
+};
+
+struct AsyncMqttClientMessageProperties {
+    uint8_t qos;
+    bool dup;
+    bool retain;
+};
+
+typedef void (*OnConnectUserCallback)(bool sessionPresent);
+typedef void (*OnDisconnectUserCallback)(AsyncMqttClientDisconnectReason reason);
+typedef void (*OnMessageUserCallback)(char *topic, char *payload, AsyncMqttClientMessageProperties properties,
+                                      size_t len, size_t index, size_t total);
+
+class AsyncMqttClient {
+public:
+    AsyncMqttClient() { native_instance = this; }
+
+    AsyncMqttClient &onConnect(OnConnectUserCallback callback) { on_connect = callback; return *this; }
+    AsyncMqttClient &onDisconnect(OnDisconnectUserCallback callback) { on_disconnect = callback; return *this; }
+    AsyncMqttClient &onMessage(OnMessageUserCallback callback) { on_message = callback; return *this; }
+
+    AsyncMqttClient &setServer(IPAddress ip, uint16_t port) { (void)ip; (void)port; return *this; }
+    AsyncMqttClient &setServer(const char *host, uint16_t port) { (void)host; (void)port; return *this; }
+    AsyncMqttClient &setCredentials(const char *user, const char *password) { (void)user; (void)password; return *this; }
+    AsyncMqttClient &setClientId(const char *id) { (void)id; return *this; }
+    AsyncMqttClient &setCleanSession(bool clean) { clean_session = clean; return *this; }
+
+    bool connected() const { return is_connected; }
+
+    void connect() {
+        is_connected = true;
+        if (on_connect) on_connect(!clean_session && session_started);
+        session_started = true;
+    }
+
+    void disconnect(bool force = false) {
+        (void)force;
+        if (!is_connected) return;
+        is_connected = false;
+        if (on_disconnect) on_disconnect(AsyncMqttClientDisconnectReason::TCP_DISCONNECTED);
+    }
+
+    uint16_t subscribe(const char *topic, uint8_t qos) {
+        (void)qos;
+        subscriptions.push_back(topic);
+        return ++packet_id;
+    }
+
+    uint16_t publish(const char *topic, uint8_t qos, bool retain, const char *payload = nullptr) {
+        (void)topic; (void)qos; (void)retain; (void)payload;
+        return ++packet_id;
+    }
+
+    // Native only: deliver a message as if it had arrived from the broker
+    bool nativeInjectMessage(const char *topic, const char *payload, bool retain = false) {
+        if (!is_connected || !on_message) return false;
+        std::string topic_buf(topic);
+        std::vector<char> payload_buf(payload, payload + strlen(payload) + 1);
+        const size_t len = payload_buf.size() - 1;
+        AsyncMqttClientMessageProperties properties = {0, false, retain};
+        on_message(&topic_buf[0], payload_buf.data(), properties, len, 0, len);
+        return true;
+    }
+
+    static AsyncMqttClient *nativeInstance() { return native_instance; }
+
+    std::vector<std::string> subscriptions;
+
+private:
+    static inline AsyncMqttClient *native_instance = nullptr;
+
+    OnConnectUserCallback on_connect = nullptr;
+    OnDisconnectUserCallback on_disconnect = nullptr;
+    OnMessageUserCallback on_message = nullptr;
+    bool is_connected = false;
+    bool clean_session = true;
+    bool session_started = false;
+    uint16_t packet_id = 0;
+};
+
+#endif // NATIVE_ASYNC_MQTT_CLIENT_H
@@ -0,0 +1,56 @@
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+
+// In-memory NVS: namespaces live for the life of the process
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class Preferences {
+public:
+    bool begin(const char *name, bool readOnly = false);
+    void end() { space = nullptr; }
+    bool clear();
+    bool remove(const char *key);
+    bool isKey(const char *key) const;
+
+    size_t putBool(const char *key, bool value) { return put(key, &value, sizeof(value)); }
+    size_t putUChar(const char *key, uint8_t value) { return put(key, &value, sizeof(value)); }
+    size_t putUShort(const char *key, uint16_t value) { return put(key, &value, sizeof(value)); }
+    size_t putInt(const char *key, int32_t value) { return put(key, &value, sizeof(value)); }
+    size_t putUInt(const char *key, uint32_t value) { return put(key, &value, sizeof(value)); }
+    size_t putFloat(const char *key, float value) { return put(key, &value, sizeof(value)); }
+    size_t putString(const char *key, const char *value) { return put(key, value, strlen(value) + 1); }
+    size_t putString(const char *key, const String &value) { return putString(key, value.c_str()); }
+    size_t putBytes(const char *key, const void *value, size_t len) { return put(key, value, len); }
+
+    bool getBool(const char *key, bool def = false) const { return get(key, def); }
+    uint8_t getUChar(const char *key, uint8_t def = 0) const { return get(key, def); }
+    uint16_t getUShort(const char *key, uint16_t def = 0) const { return get(key, def); }
+    int32_t getInt(const char *key, int32_t def = 0) const { return get(key, def); }
+    uint32_t getUInt(const char *key, uint32_t def = 0) const { return get(key, def); }
+    float getFloat(const char *key, float def = 0) const { return get(key, def); }
+    String getString(const char *key, const String def = String()) const;
+    size_t getBytesLength(const char *key) const;
+    size_t getBytes(const char *key, void *buf, size_t maxLen) const;
+
+private:
+    typedef std::map<std::string, std::vector<uint8_t>> Namespace;
+
+    size_t put(const char *key, const void *value, size_t len);
+    const std::vector<uint8_t> *find(const char *key) const;
+    template <typename T> T get(const char *key, T def) const {
+        const std::vector<uint8_t> *value = find(key);
+        if (!value || value->size() != sizeof(T)) return def;
+        T result;
+        memcpy(&result, value->data(), sizeof(T));
+        return result;
+    }
+
+    Namespace *space = nullptr;
+    bool read_only = false;
+};
+
+#endif // NATIVE_PREFERENCES_H
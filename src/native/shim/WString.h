@@ -0,0 +1,77 @@
+#ifndef NATIVE_WSTRING_H
+#define NATIVE_WSTRING_H
+
+// Arduino String on top of std::string (only the members the firmware uses)
+
+#include <stdlib.h>
+#include <string>
+
+class String {
+public:
+    String() {}
+    String(const char *s) : str(s ? s : "") {}
+    String(const std::string &s) : str(s) {}
+    String(char c) : str(1, c) {}
+    String(int v) : str(std::to_string(v)) {}
+    String(unsigned int v) : str(std::to_string(v)) {}
+    String(long v) : str(std::to_string(v)) {}
+    String(unsigned long v) : str(std::to_string(v)) {}
+    String(float v, unsigned int decimals = 2) { format(v, decimals); }
+    String(double v, unsigned int decimals = 2) { format(v, decimals); }
+
+    const char *c_str() const { return str.c_str(); }
+    unsigned int length() const { return (unsigned int)str.length(); }
+    bool isEmpty() const { return str.empty(); }
+    char operator[](unsigned int i) const { return i < str.length() ? str[i] : 0; }
+
+    int indexOf(char c, unsigned int from = 0) const { return pos(str.find(c, from)); }
+    int indexOf(const char *s, unsigned int from = 0) const { return pos(str.find(s, from)); }
+    int lastIndexOf(char c) const { return pos(str.rfind(c)); }
+    bool startsWith(const String &s) const { return str.compare(0, s.str.length(), s.str) == 0; }
+    bool endsWith(const String &s) const {
+        return str.length() >= s.str.length() &&
+               str.compare(str.length() - s.str.length(), s.str.length(), s.str) == 0;
+    }
+
+    String substring(unsigned int from) const { return from < str.length() ? str.substr(from) : std::string(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        return from < str.length() ? str.substr(from, to - from) : std::string();
+    }
+
+    void trim() {
+        const size_t first = str.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos) { str.clear(); return; }
+        str = str.substr(first, str.find_last_not_of(" \t\r\n") - first + 1);
+    }
+    void toLowerCase() { for (char &c : str) c = (char)tolower((unsigned char)c); }
+    void toUpperCase() { for (char &c : str) c = (char)toupper((unsigned char)c); }
+    long toInt() const { return atol(str.c_str()); }
+    float toFloat() const { return (float)atof(str.c_str()); }
+
+    String &operator+=(const String &s) { str += s.str; return *this; }
+    String &operator+=(const char *s) { str += s; return *this; }
+    String &operator+=(char c) { str += c; return *this; }
+
+    friend String operator+(const String &a, const String &b) { return a.str + b.str; }
+    friend String operator+(const String &a, const char *b) { return a.str + b; }
+    friend String operator+(const char *a, const String &b) { return a + b.str; }
+    friend String operator+(const String &a, char b) { return a.str + b; }
+
+    bool operator==(const String &s) const { return str == s.str; }
+    bool operator==(const char *s) const { return str == (s ? s : ""); }
+    bool operator!=(const String &s) const { return str != s.str; }
+    bool operator!=(const char *s) const { return !(*this == s); }
+
+private:
+    static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+    void format(double v, unsigned int decimals) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        str = buf;
+    }
+
+    std::string str;
+};
+
+#endif // NATIVE_WSTRING_H
@@ -0,0 +1,32 @@
+#ifndef NATIVE_WIFI_H
+#define NATIVE_WIFI_H
+
+// Always-connected station; hostByName resolves everything to loopback
+
+#include <Arduino.h>
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+class WiFiClass {
+public:
+    wl_status_t status() { return connected ? WL_CONNECTED : WL_DISCONNECTED; }
+    String SSID() { return String("native"); }
+    IPAddress localIP() { return connected ? IPAddress(127, 0, 0, 1) : IPAddress(); }
+    int hostByName(const char *host, IPAddress &result) {
+        if (!result.fromString(host)) result = IPAddress(127, 0, 0, 1);
+        return 1;
+    }
+
+    // Native only: simulate a link drop
+    bool connected = true;
+};
+extern WiFiClass WiFi;
+
+#endif // NATIVE_WIFI_H
@@ -0,0 +1,10 @@
+#ifndef NATIVE_ESP_ATTR_H
+#define NATIVE_ESP_ATTR_H
+
+// No RTC memory on the host: "survives a reboot" data is ordinary BSS
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#endif // NATIVE_ESP_ATTR_H
@@ -0,0 +1,9 @@
+#ifndef NATIVE_ESP_RANDOM_H
+#define NATIVE_ESP_RANDOM_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+inline uint32_t esp_random() { return ((uint32_t)rand() << 16) ^ (uint32_t)rand(); }
+
+#endif // NATIVE_ESP_RANDOM_H
@@ -0,0 +1,16 @@
+#ifndef NATIVE_ESP_TIMER_H
+#define NATIVE_ESP_TIMER_H
+
+// Real monotonic time (the virtual millis() clock is only for firmware logic),
+// so the ingest and render timings measure the host CPU
+
+#include <stdint.h>
+#include <time.h>
+
+inline int64_t esp_timer_get_time() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+#endif // NATIVE_ESP_TIMER_H
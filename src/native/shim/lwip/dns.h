@@ -0,0 +1,31 @@
+#ifndef NATIVE_LWIP_DNS_H
+#define NATIVE_LWIP_DNS_H
+
+// Synchronous lookups: literals resolve to themselves, everything else to loopback
+
+#include <stdint.h>
+#include <IPAddress.h>
+
+typedef int8_t err_t;
+#define ERR_OK 0
+#define ERR_INPROGRESS -5
+#define ERR_ARG -16
+
+struct ip4_addr_t { uint32_t addr; };
+struct ip_addr_t { ip4_addr_t ip4; };
+
+#define IP_IS_V4(ipaddr) ((ipaddr) != nullptr)
+#define ip_2_ip4(ipaddr) (&(ipaddr)->ip4)
+#define ip4_addr_get_u32(src_ipaddr) ((src_ipaddr)->addr)
+
+typedef void (*dns_found_callback)(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+
+inline err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback, void *) {
+    if (!hostname || !*hostname) return ERR_ARG;
+    IPAddress ip;
+    if (!ip.fromString(hostname)) ip = IPAddress(127, 0, 0, 1);
+    addr->ip4.addr = (uint32_t)ip;
+    return ERR_OK;
+}
+
+#endif // NATIVE_LWIP_DNS_H
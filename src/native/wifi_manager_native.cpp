@@ -0,0 +1,20 @@
+#include "wifi_manager.h"
+
+// The screens only need these; the native station is always connected
+
+Preferences wifi_preferences;
+
+void retryWiFiConnection() {
+}
+
+unsigned long getNextWiFiRetryTime() {
+    return 0;
+}
+
+bool hasWifiCredentials() {
+    return true;
+}
+
+bool isWiFiConnecting() {
+    return false;
+}
@@ -0,0 +1,151 @@
+#include "network_recovery.h"
+#include "wifi_manager.h"
+#include "mqtt_client.h"
+#include <esp_attr.h>
+
+#define RECOVERY_RTC_MAGIC 0x5245434F  // "RECO"
+
+// Reboot count survives the software reset it causes
+struct RtcRecovery {
+    uint32_t magic;
+    uint32_t reboots;
+};
+RTC_NOINIT_ATTR static RtcRecovery rtc_recovery;
+
+static NetworkRecoveryStats recovery_stats = {};
+static bool recovery_initialized = false;
+static bool recovery_armed = false;       // Network has been healthy at least once
+static unsigned long outage_start = 0;
+static unsigned long step_started_at = 0;
+static uint8_t steps_run = 0;  // Bit per RecoveryStep run in this outage
+static unsigned long reboot_at = 0;
+
+static const unsigned long step_delay_ms[RECOVERY_STEP_COUNT] = {
+    0,
+    NET_RECOVERY_WIFI_RESET_MS,
+    NET_RECOVERY_MQTT_REINIT_MS,
+    NET_RECOVERY_REBOOT_MS,
+};
+
+static bool mqttConfigured() {
+    return mqttClient.getConfig().host.length() > 0;
+}
+
+static void runStep(RecoveryStep step, unsigned long now) {
+    recovery_stats.step = step;
+    recovery_stats.steps[step].runs++;
+    step_started_at = now;
+    Serial.printf("Network recovery: %s (outage %lu s)\n",
+                  getRecoveryStepName(step), (now - outage_start) / 1000);
+
+    switch (step) {
+        case RECOVERY_WIFI_RESET:
+            resetWiFiDriver();
+            break;
+        case RECOVERY_MQTT_REINIT:
+            mqttClient.reinit();
+            break;
+        case RECOVERY_REBOOT:
+            rtc_recovery.reboots++;
+            reboot_at = now + NET_RECOVERY_REBOOT_DELAY;
+            break;
+        default:
+            break;
+    }
+}
+
+// Whether a step still helps given what is down right now
+static bool stepApplies(RecoveryStep step, bool wifi_ok, bool mqtt_ok) {
+    switch (step) {
+        case RECOVERY_WIFI_RESET:
+        case RECOVERY_REBOOT:
+            return !wifi_ok;
+        case RECOVERY_MQTT_REINIT:
+            return wifi_ok && !mqtt_ok;
+        default:
+            return false;
+    }
+}
+
+void loopNetworkRecovery() {
+    if (!recovery_initialized) {
+        if (rtc_recovery.magic != RECOVERY_RTC_MAGIC) {
+            rtc_recovery.magic = RECOVERY_RTC_MAGIC;
+            rtc_recovery.reboots = 0;
+        }
+        recovery_initialized = true;
+    }
+    recovery_stats.recovery_reboots = rtc_recovery.reboots;
+
+    const unsigned long now = millis();
+    if (reboot_at != 0) {
+        if ((long)(now - reboot_at) >= 0) ESP.restart();
+        return;
+    }
+
+    const bool wifi_ok = getWiFiStats().state == WIFI_STATE_CONNECTED;
+    const bool mqtt_ok = !mqttConfigured() || mqttClient.isConnected();
+    const bool healthy = wifi_ok && mqtt_ok;
+
+    if (!recovery_armed) {
+        // Initial connection and provisioning are not outages
+        recovery_armed = healthy;
+        return;
+    }
+
+    if (healthy) {
+        if (recovery_stats.in_outage) {
+            RecoveryStepStats &step = recovery_stats.steps[recovery_stats.step];
+            step.recoveries++;
+            step.last_recovery_ms = now - step_started_at;
+            recovery_stats.last_outage_ms = now - outage_start;
+            if (recovery_stats.last_outage_ms > recovery_stats.longest_outage_ms) {
+                recovery_stats.longest_outage_ms = recovery_stats.last_outage_ms;
+            }
+            recovery_stats.in_outage = false;
+            Serial.printf("Network recovered after %lu ms (%s)\n",
+                          (unsigned long)recovery_stats.last_outage_ms,
+                          getRecoveryStepName(recovery_stats.step));
+        }
+        return;
+    }
+
+    if (!recovery_stats.in_outage) {
+        recovery_stats.in_outage = true;
+        recovery_stats.outages++;
+        outage_start = now;
+        steps_run = 0;
+        // WiFi and MQTT retry on their own; that is the first step
+        runStep(RECOVERY_RECONNECT, now);
+        return;
+    }
+
+    // Run the first due step that applies now. Steps that don't apply yet stay
+    // pending, e.g. mqtt_reinit once WiFi is back but the broker is still down.
+    // A late step still leaves the previous step its usual time to work.
+    for (uint8_t i = RECOVERY_WIFI_RESET; i < RECOVERY_STEP_COUNT; i++) {
+        const RecoveryStep step = (RecoveryStep)i;
+        if (steps_run & (1 << i)) continue;
+        if (now - outage_start < step_delay_ms[i]) break;
+        if (now - step_started_at < step_delay_ms[i] - step_delay_ms[i - 1]) continue;
+        if (stepApplies(step, wifi_ok, mqtt_ok)) {
+            steps_run |= 1 << i;
+            runStep(step, now);
+            break;
+        }
+    }
+}
+
+const NetworkRecoveryStats& getNetworkRecoveryStats() {
+    return recovery_stats;
+}
+
+const char* getRecoveryStepName(RecoveryStep step) {
+    switch (step) {
+        case RECOVERY_RECONNECT:   return "reconnect";
+        case RECOVERY_WIFI_RESET:  return "wifi_reset";
+        case RECOVERY_MQTT_REINIT: return "mqtt_reinit";
+        case RECOVERY_REBOOT:      return "reboot";
+        default:                   return "unknown";
+    }
+}
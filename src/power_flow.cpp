@@ -0,0 +1,121 @@
+#include "power_flow.h"
+#include <string.h>
+
+#define MAX_SINK_ROLES 3
+
+static const char *const role_names[NODE_ROLE_COUNT] = {
+    "solar", "generator", "grid", "battery", "home", "ev"
+};
+
+static const PowerNodeRole source_order[] = { NODE_SOLAR, NODE_GENERATOR, NODE_GRID, NODE_BATTERY };
+
+// Sinks each source role feeds, by priority (NODE_ROLE_COUNT ends the list)
+static const PowerNodeRole sink_order[NODE_ROLE_COUNT][MAX_SINK_ROLES] = {
+    { NODE_BATTERY, NODE_HOME, NODE_GRID },              // Solar
+    { NODE_HOME, NODE_BATTERY, NODE_ROLE_COUNT },        // Generator
+    { NODE_BATTERY, NODE_HOME, NODE_ROLE_COUNT },        // Grid
+    { NODE_HOME, NODE_GRID, NODE_ROLE_COUNT },           // Battery
+    { NODE_ROLE_COUNT, NODE_ROLE_COUNT, NODE_ROLE_COUNT },  // Home
+    { NODE_ROLE_COUNT, NODE_ROLE_COUNT, NODE_ROLE_COUNT },  // EV
+};
+
+static inline float positive(float v) {
+    return v > 0.0f ? v : 0.0f;
+}
+
+uint8_t addPowerNode(PowerTopology &topology, PowerNodeRole role, uint8_t feeder) {
+    if (topology.count >= POWER_FLOW_MAX_NODES) return POWER_NODE_NONE;
+    PowerNode &node = topology.nodes[topology.count];
+    node.role = role;
+    node.w = 0.0f;
+    node.soc = 0.0f;
+    node.feeder = feeder;
+    return topology.count++;
+}
+
+bool canPowerFlow(PowerNodeRole from, PowerNodeRole to) {
+    if (from >= NODE_ROLE_COUNT) return false;
+    for (uint8_t k = 0; k < MAX_SINK_ROLES; k++) {
+        if (sink_order[from][k] == to) return true;
+    }
+    return false;
+}
+
+static void addFlow(PowerFlowResult &result, uint8_t from, uint8_t to, float w) {
+    if (result.count >= POWER_FLOW_MAX_EDGES) return;
+    PowerFlow &flow = result.flows[result.count++];
+    flow.from = from;
+    flow.to = to;
+    flow.w = w;
+    if (isPowerFlowActive(w) && w > result.max_active) result.max_active = w;
+}
+
+void solvePowerFlows(const PowerTopology &topology, PowerFlowResult &result) {
+    const uint8_t n = topology.count;
+    const PowerNode *nodes = topology.nodes;
+    result.count = 0;
+    result.max_active = 0.0f;
+
+    // Bucket nodes by role so each source only visits candidate sinks
+    float supply[POWER_FLOW_MAX_NODES];
+    float demand[POWER_FLOW_MAX_NODES];
+    uint8_t by_role[NODE_ROLE_COUNT][POWER_FLOW_MAX_NODES];
+    uint8_t role_count[NODE_ROLE_COUNT] = {0};
+    for (uint8_t i = 0; i < n; i++) {
+        const PowerNodeRole role = nodes[i].role;
+        const float w = nodes[i].w;
+        if (role >= NODE_ROLE_COUNT) continue;
+        by_role[role][role_count[role]++] = i;
+        switch (role) {
+            case NODE_SOLAR:
+            case NODE_GENERATOR: supply[i] = positive(w); demand[i] = 0.0f; break;
+            case NODE_GRID:
+            case NODE_BATTERY:   supply[i] = positive(w); demand[i] = positive(-w); break;
+            case NODE_HOME:      supply[i] = 0.0f; demand[i] = positive(w); break;
+            default:             supply[i] = 0.0f; demand[i] = 0.0f; break;
+        }
+    }
+
+    for (PowerNodeRole source_role : source_order) {
+        for (uint8_t s = 0; s < role_count[source_role]; s++) {
+            const uint8_t i = by_role[source_role][s];
+
+            for (uint8_t k = 0; k < MAX_SINK_ROLES && supply[i] > 0.0f; k++) {
+                const PowerNodeRole sink_role = sink_order[source_role][k];
+                if (sink_role == NODE_ROLE_COUNT) break;
+
+                for (uint8_t d = 0; d < role_count[sink_role] && supply[i] > 0.0f; d++) {
+                    const uint8_t j = by_role[sink_role][d];
+                    if (demand[j] <= 0.0f) continue;
+                    if (source_role == NODE_SOLAR && sink_role == NODE_BATTERY &&
+                        nodes[j].soc >= POWER_FLOW_BATTERY_FULL_SOC) {
+                        continue;
+                    }
+                    const float w = supply[i] < demand[j] ? supply[i] : demand[j];
+                    supply[i] -= w;
+                    demand[j] -= w;
+                    addFlow(result, i, j, w);
+                }
+            }
+        }
+    }
+
+    for (uint8_t e = 0; e < role_count[NODE_EV]; e++) {
+        const uint8_t i = by_role[NODE_EV][e];
+        const PowerNode &node = nodes[i];
+        if (node.feeder < n && node.w > POWER_FLOW_THRESHOLD_W) {
+            addFlow(result, node.feeder, i, node.w);
+        }
+    }
+}
+
+const char* getPowerNodeRoleName(PowerNodeRole role) {
+    return role < NODE_ROLE_COUNT ? role_names[role] : "";
+}
+
+PowerNodeRole parsePowerNodeRole(const char *name) {
+    for (uint8_t i = 0; i < NODE_ROLE_COUNT; i++) {
+        if (strcmp(name, role_names[i]) == 0) return (PowerNodeRole)i;
+    }
+    return NODE_ROLE_COUNT;
+}
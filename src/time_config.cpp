@@ -1,4 +1,7 @@
 #include "time_config.h"
+#include "wall_clock.h"
+#include <esp_sntp.h>
+#include <esp_timer.h>
 
 // Global instance
 TimeConfigManager timeConfig;
@@ -14,11 +17,10 @@ void TimeConfigManager::begin() {
     config.ntpEnabled = preferences.getBool("ntpEnabled", true);
     
     preferences.end();
-    
-    // Initialize NTP if enabled
-    if (config.ntpEnabled) {
-        syncTime();
-    }
+
+    // Apply the timezone now; NTP sync is started by the caller once WiFi is up
+    setenv("TZ", config.timezone.c_str(), 1);
+    tzset();
 }
 
 void TimeConfigManager::saveConfig() {
@@ -30,62 +32,138 @@ void TimeConfigManager::saveConfig() {
     
     preferences.end();
     
-    // Re-sync time with new settings
-    if (config.ntpEnabled) {
-        syncTime();
-    }
+    // Re-sync time with new settings (stops SNTP if it was disabled)
+    syncTime();
 }
 
 TimeConfig& TimeConfigManager::getConfig() {
     return config;
 }
 
+// Set from the SNTP task, consumed in loop()
+static volatile bool sntp_event_pending = false;
+static volatile int64_t sntp_event_epoch_us = 0;
+static volatile int64_t sntp_event_timer_us = 0;
+
+static void onSntpTimeSync(struct timeval *tv) {
+    sntp_event_epoch_us = (int64_t)tv->tv_sec * 1000000LL + tv->tv_usec;
+    sntp_event_timer_us = esp_timer_get_time();
+    sntp_event_pending = true;
+}
+
 void TimeConfigManager::syncTime() {
+    // May be called from the web server task; SNTP is (re)started from loop()
+    syncRequested = true;
+}
+
+void TimeConfigManager::startSync() {
     if (!config.ntpEnabled) {
+        sntp_stop();
+        setenv("TZ", config.timezone.c_str(), 1);
+        tzset();
+        stats.state = TIME_SYNC_IDLE;
         return;
     }
-    
+
     Serial.printf("Syncing time with NTP server: %s\n", config.ntpServer.c_str());
     Serial.printf("Timezone: %s\n", config.timezone.c_str());
-    
-    // Configure NTP with timezone
+
+    sntp_set_time_sync_notification_cb(onSntpTimeSync);
+    sntp_set_sync_interval(TIME_RESYNC_INTERVAL_MS);
+
+    // Configure NTP with timezone (configTime resets TZ, so apply ours after)
     configTime(0, 0, config.ntpServer.c_str());
     setenv("TZ", config.timezone.c_str(), 1);
     tzset();
-    
-    // Wait for time to be set (with timeout)
+
+    // The previous sync can't be compared against a different server's time
+    lastSyncEpochUs = 0;
+    syncStartMs = millis();
+    stats.state = TIME_SYNC_PENDING;
+}
+
+void TimeConfigManager::loop() {
+    if (syncRequested) {
+        syncRequested = false;
+        startSync();
+    }
+
+    if (sntp_event_pending) {
+        sntp_event_pending = false;
+        handleSyncEvent();
+    }
+
+    if (stats.state == TIME_SYNC_PENDING && millis() - syncStartMs >= TIME_SYNC_TIMEOUT_MS) {
+        stats.state = TIME_SYNC_FAILED;
+        stats.fail_count++;
+        Serial.println("Failed to sync time with NTP server (still retrying)");
+        notifySync(false);
+    }
+}
+
+void TimeConfigManager::handleSyncEvent() {
+    const int64_t epoch_us = sntp_event_epoch_us;
+    const int64_t timer_us = sntp_event_timer_us;
+
+    // Drift: how far the wall clock ran from NTP since the last sync
+    if (lastSyncEpochUs != 0) {
+        const int64_t elapsed_us = timer_us - lastSyncTimerUs;
+        const int64_t expected_us = lastSyncEpochUs + elapsed_us;
+        stats.last_drift_ms = (int32_t)((epoch_us - expected_us) / 1000);
+        if (elapsed_us > 0) {
+            stats.drift_ppm = (float)(epoch_us - expected_us) * 1e6f / (float)elapsed_us;
+        }
+    }
+    lastSyncEpochUs = epoch_us;
+    lastSyncTimerUs = timer_us;
+
+    const bool first = stats.state != TIME_SYNC_SYNCED;
+    if (first) {
+        stats.last_duration_ms = millis() - syncStartMs;
+    }
+    stats.state = TIME_SYNC_SYNCED;
+    stats.sync_count++;
+    stats.last_sync_ms = millis();
+    timeSynced = true;
+
     struct tm timeinfo;
-    int retries = 0;
-    while (!getLocalTime(&timeinfo) && retries < 10) {
-        delay(500);
-        retries++;
+    if (getLocalTime(&timeinfo)) {
+        Serial.printf("Time synced: %02d:%02d:%02d (drift %ld ms)\n",
+                      timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec,
+                      (long)stats.last_drift_ms);
     }
-    
-    if (retries < 10) {
-        timeSynced = true;
-        Serial.printf("Time synced: %02d:%02d:%02d\n", 
-                     timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
-    } else {
-        Serial.println("Failed to sync time with NTP server");
-        timeSynced = false;
+
+    if (first) {
+        notifySync(true);
     }
 }
 
+void TimeConfigManager::notifySync(bool success) {
+    if (syncCallback) {
+        syncCallback(success);
+    }
+}
+
+void TimeConfigManager::setSyncCallback(void (*callback)(bool success)) {
+    syncCallback = callback;
+}
+
+const TimeSyncStats& TimeConfigManager::getSyncStats() {
+    return stats;
+}
+
 bool TimeConfigManager::isTimeSynced() {
     return timeSynced;
 }
 
 bool TimeConfigManager::getLocalTime(struct tm *timeinfo) {
-    if (!::getLocalTime(timeinfo)) {
+    // Zero timeout: the Arduino default waits up to 5 s for an unsynced clock
+    if (!::getLocalTime(timeinfo, 0)) {
         return false;
     }
     return true;
 }
 
 int TimeConfigManager::getCurrentHour() {
-    struct tm timeinfo;
-    if (!getLocalTime(&timeinfo)) {
-        return -1;  // Error getting time
-    }
-    return timeinfo.tm_hour;
+    return wallClockHour();  // Cached, -1 until time is set
 }
@@ -0,0 +1,30 @@
+#include "ui_screens.h"
+#include "ui_styles.h"
+#include "glyph_cache.h"
+#include "lazy_screens.h"
+#include "main_screen.h"
+#include "info_screen.h"
+#include "config_screen.h"
+#include "mqtt_config_screen.h"
+#include "wifi_error_screen.h"
+
+// Secondary screens are torn down after this long off-screen
+#define SCREEN_IDLE_TEARDOWN_MS 60000
+
+void createScreens() {
+    initUIStyles();    // Shared styles must exist before any screen references them
+    initGlyphCache();  // Must precede any glyph label creation
+    createMainDashboard();
+
+    // Secondary screens are created on first show (see lazy_screens)
+    registerLazyScreen(LAZY_SCREEN_INFO, "info",
+                       createInfoScreen, destroyInfoScreen, isInfoScreenVisible, SCREEN_IDLE_TEARDOWN_MS);
+    registerLazyScreen(LAZY_SCREEN_CONFIG, "config",
+                       createConfigScreen, destroyConfigScreen, isConfigScreenVisible, SCREEN_IDLE_TEARDOWN_MS);
+    registerLazyScreen(LAZY_SCREEN_MQTT_CONFIG, "mqtt_config",
+                       []() { createMqttConfigScreen(getMainScreen()); },
+                       destroyMqttConfigScreen, isMqttConfigScreenVisible, SCREEN_IDLE_TEARDOWN_MS);
+    registerLazyScreen(LAZY_SCREEN_WIFI_ERROR, "wifi_error",
+                       []() { createWifiErrorScreen(getMainScreen()); },
+                       destroyWifiErrorScreen, isWifiErrorScreenVisible, SCREEN_IDLE_TEARDOWN_MS);
+}
@@ -0,0 +1,174 @@
+#include "ui_styles.h"
+#include "lvgl_heap.h"
+#include <Arduino.h>
+
+// Theme colors (matching main screen)
+#define COLOR_BG        0x0A0C10
+#define COLOR_WHITE     0xFFFFFF
+#define COLOR_GRAY      0x6A6A6A
+#define COLOR_GREEN     0x22C55E
+#define COLOR_RED       0xEF4444
+#define COLOR_BTN_DARK  0x2A2D32
+#define COLOR_ORANGE    0xF59E0B
+
+// Flow/indicator colors
+#define COLOR_GRID      0x8A8A8A
+#define COLOR_SOLAR     0xFFD54A
+#define COLOR_BATTERY   0x64DD17
+#define COLOR_EV        0x06B6D4
+#define COLOR_GENERATOR 0xF97316
+#define COLOR_RX        0xFF0000
+#define COLOR_BAR_BG    0x16181C
+#define COLOR_BAR_FILL  0x22C55E
+#define COLOR_BAR_BORDER 0x5A5A5A
+
+lv_style_t ui_style_screen;
+lv_style_t ui_style_overlay;
+lv_style_t ui_style_title;
+lv_style_t ui_style_header;
+lv_style_t ui_style_info_value;
+lv_style_t ui_style_status_ok;
+lv_style_t ui_style_status_error;
+lv_style_t ui_style_url;
+lv_style_t ui_style_message;
+lv_style_t ui_style_btn;
+lv_style_t ui_style_btn_dark;
+lv_style_t ui_style_btn_warning;
+lv_style_t ui_style_btn_danger;
+lv_style_t ui_style_btn_label;
+lv_style_t ui_style_btn_label_16;
+lv_style_t ui_style_value_label;
+lv_style_t ui_style_align_left;
+lv_style_t ui_style_align_right;
+lv_style_t ui_style_ev_soc;
+lv_style_t ui_style_dot;
+lv_style_t ui_style_dot_solar;
+lv_style_t ui_style_dot_grid;
+lv_style_t ui_style_dot_battery;
+lv_style_t ui_style_dot_ev;
+lv_style_t ui_style_dot_generator;
+lv_style_t ui_style_dot_rx;
+lv_style_t ui_style_node_badge;
+lv_style_t ui_style_badge_generator;
+lv_style_t ui_style_badge_battery;
+lv_style_t ui_style_badge_ev;
+lv_style_t ui_style_bar_main;
+lv_style_t ui_style_bar_indicator;
+lv_style_t ui_style_stale;
+
+static bool ui_styles_ready = false;
+
+static void initTextStyle(lv_style_t *style, uint32_t color, const lv_font_t *font) {
+    lv_style_init(style);
+    lv_style_set_text_color(style, lv_color_hex(color));
+    if (font) lv_style_set_text_font(style, font);
+}
+
+static void initBgStyle(lv_style_t *style, uint32_t color) {
+    lv_style_init(style);
+    lv_style_set_bg_color(style, lv_color_hex(color));
+}
+
+static void initBorderStyle(lv_style_t *style, uint32_t color) {
+    lv_style_init(style);
+    lv_style_set_border_color(style, lv_color_hex(color));
+}
+
+void initUIStyles() {
+    if (ui_styles_ready) return;
+
+    // Screens
+    initBgStyle(&ui_style_screen, COLOR_BG);
+
+    initBgStyle(&ui_style_overlay, COLOR_BG);
+    lv_style_set_bg_opa(&ui_style_overlay, LV_OPA_COVER);
+    lv_style_set_border_width(&ui_style_overlay, 0);
+    lv_style_set_radius(&ui_style_overlay, 0);
+
+    // Text
+    initTextStyle(&ui_style_title, COLOR_WHITE, &lv_font_montserrat_24);
+    initTextStyle(&ui_style_header, COLOR_GRAY, &lv_font_montserrat_16);
+    initTextStyle(&ui_style_info_value, COLOR_WHITE, &lv_font_montserrat_16);
+    initTextStyle(&ui_style_status_ok, COLOR_GREEN, nullptr);
+    initTextStyle(&ui_style_status_error, COLOR_RED, nullptr);
+
+    lv_style_init(&ui_style_url);
+    lv_style_set_text_font(&ui_style_url, &lv_font_montserrat_20);
+
+    initTextStyle(&ui_style_message, COLOR_GRAY, &lv_font_montserrat_20);
+    lv_style_set_text_align(&ui_style_message, LV_TEXT_ALIGN_CENTER);
+
+    // Buttons
+    lv_style_init(&ui_style_btn);
+    lv_style_set_radius(&ui_style_btn, 8);
+
+    initBgStyle(&ui_style_btn_dark, COLOR_BTN_DARK);
+    initBgStyle(&ui_style_btn_warning, COLOR_ORANGE);
+    initBgStyle(&ui_style_btn_danger, COLOR_RED);
+
+    initTextStyle(&ui_style_btn_label, COLOR_WHITE, nullptr);
+    initTextStyle(&ui_style_btn_label_16, COLOR_WHITE, &lv_font_montserrat_16);
+
+    // Dashboard value labels
+    initTextStyle(&ui_style_value_label, COLOR_WHITE, nullptr);
+    lv_style_set_text_align(&ui_style_value_label, LV_TEXT_ALIGN_CENTER);
+
+    lv_style_init(&ui_style_align_left);
+    lv_style_set_text_align(&ui_style_align_left, LV_TEXT_ALIGN_LEFT);
+    lv_style_init(&ui_style_align_right);
+    lv_style_set_text_align(&ui_style_align_right, LV_TEXT_ALIGN_RIGHT);
+
+    initTextStyle(&ui_style_ev_soc, COLOR_EV, &lv_font_montserrat_14);
+    lv_style_set_text_align(&ui_style_ev_soc, LV_TEXT_ALIGN_CENTER);
+
+    // Flow dots (bg_opa stays a local style, it is animated per dot)
+    lv_style_init(&ui_style_dot);
+    lv_style_set_radius(&ui_style_dot, LV_RADIUS_CIRCLE);
+    lv_style_set_bg_opa(&ui_style_dot, LV_OPA_TRANSP);
+    lv_style_set_border_width(&ui_style_dot, 0);
+
+    initBgStyle(&ui_style_dot_solar, COLOR_SOLAR);
+    initBgStyle(&ui_style_dot_grid, COLOR_GRID);
+    initBgStyle(&ui_style_dot_battery, COLOR_BATTERY);
+    initBgStyle(&ui_style_dot_ev, COLOR_EV);
+    initBgStyle(&ui_style_dot_generator, COLOR_GENERATOR);
+    initBgStyle(&ui_style_dot_rx, COLOR_RX);
+
+    // Extra flow node badges
+    initBgStyle(&ui_style_node_badge, COLOR_BG);
+    lv_style_set_bg_opa(&ui_style_node_badge, LV_OPA_COVER);
+    lv_style_set_radius(&ui_style_node_badge, LV_RADIUS_CIRCLE);
+    lv_style_set_border_width(&ui_style_node_badge, 3);
+    lv_style_set_pad_all(&ui_style_node_badge, 0);
+
+    initBorderStyle(&ui_style_badge_generator, COLOR_GENERATOR);
+    initBorderStyle(&ui_style_badge_battery, COLOR_BATTERY);
+    initBorderStyle(&ui_style_badge_ev, COLOR_EV);
+
+    // SOC bar
+    initBgStyle(&ui_style_bar_main, COLOR_BAR_BG);
+    lv_style_set_bg_opa(&ui_style_bar_main, LV_OPA_30);
+    lv_style_set_border_width(&ui_style_bar_main, 1);
+    lv_style_set_border_color(&ui_style_bar_main, lv_color_hex(COLOR_BAR_BORDER));
+    lv_style_set_radius(&ui_style_bar_main, 2);
+
+    initBgStyle(&ui_style_bar_indicator, COLOR_BAR_FILL);
+    lv_style_set_bg_opa(&ui_style_bar_indicator, LV_OPA_COVER);
+    lv_style_set_radius(&ui_style_bar_indicator, 2);
+
+    // Restored values (applied with UI_STATE_STALE)
+    lv_style_init(&ui_style_stale);
+    lv_style_set_text_opa(&ui_style_stale, LV_OPA_50);
+
+    ui_styles_ready = true;
+}
+
+uint32_t logLvglMemory(const char *tag) {
+    lvgl_heap_stats_t stats;
+    lvgl_heap_get_stats(&stats);
+    Serial.printf("LVGL memory [%s]: %u used, %u free, %u%% frag, biggest free %u (internal %u used)\n",
+                  tag, (unsigned)stats.used_bytes, (unsigned)stats.free_bytes,
+                  (unsigned)stats.frag_pct, (unsigned)stats.largest_free_block,
+                  (unsigned)stats.fast_used_bytes);
+    return stats.used_bytes;
+}
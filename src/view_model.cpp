@@ -0,0 +1,77 @@
+#include "view_model.h"
+#include "glyph_cache.h"
+#include <Arduino.h>
+
+static ViewStats view_stats = {0, 0};
+
+// Separates the main and accent spans in the cached glyph label text
+#define VIEW_ACCENT_SEPARATOR '\x1F'
+
+void viewBind(WidgetView &view, lv_obj_t *obj) {
+    view.obj = obj;
+    view.text_valid = false;
+    view.opa_valid = false;
+    view.hidden_valid = false;
+    view.text[0] = '\0';
+}
+
+// Returns true (and caches the text) if it differs from the last applied one
+static bool textChanged(WidgetView &view, const char *text) {
+    if (view.text_valid && strncmp(view.text, text, sizeof(view.text)) == 0) {
+        view_stats.suppressed++;
+        return false;
+    }
+    strlcpy(view.text, text, sizeof(view.text));
+    view.text_valid = true;
+    view_stats.applied++;
+    return true;
+}
+
+void viewSetLabelText(WidgetView &view, const char *text) {
+    if (!view.obj) return;
+    if (textChanged(view, text)) {
+        lv_label_set_text(view.obj, text);
+    }
+}
+
+void viewSetGlyphText(WidgetView &view, const char *text, const char *accent) {
+    if (!view.obj) return;
+
+    char key[VIEW_TEXT_MAX];
+    snprintf(key, sizeof(key), "%s%c%s", text, VIEW_ACCENT_SEPARATOR, accent ? accent : "");
+    if (textChanged(view, key)) {
+        setGlyphLabelText(view.obj, text, accent);
+    }
+}
+
+void viewSetOpa(WidgetView &view, lv_opa_t opa) {
+    if (!view.obj) return;
+    if (view.opa_valid && view.opa == opa) {
+        view_stats.suppressed++;
+        return;
+    }
+    view.opa = opa;
+    view.opa_valid = true;
+    view_stats.applied++;
+    lv_obj_set_style_opa(view.obj, opa, 0);
+}
+
+void viewSetHidden(WidgetView &view, bool hidden) {
+    if (!view.obj) return;
+    if (view.hidden_valid && view.hidden == hidden) {
+        view_stats.suppressed++;
+        return;
+    }
+    view.hidden = hidden;
+    view.hidden_valid = true;
+    view_stats.applied++;
+    if (hidden) {
+        lv_obj_add_flag(view.obj, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_clear_flag(view.obj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+const ViewStats& getViewStats() {
+    return view_stats;
+}
@@ -0,0 +1,79 @@
+#include "wall_clock.h"
+
+// Anything earlier means the clock has not been set by NTP
+#define WALL_CLOCK_MIN_VALID_YEAR (2016 - 1900)
+
+static struct tm wall_clock = {};
+static bool wall_clock_valid = false;
+static time_t wall_clock_epoch = 0;
+
+static WallClockListener minute_listeners[WALL_CLOCK_MAX_LISTENERS];
+static WallClockListener hour_listeners[WALL_CLOCK_MAX_LISTENERS];
+static uint8_t minute_listener_count = 0;
+static uint8_t hour_listener_count = 0;
+
+static void notify(WallClockListener *listeners, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        listeners[i](wall_clock);
+    }
+}
+
+void updateWallClock() {
+    const time_t now = time(nullptr);
+    if (now == wall_clock_epoch) return;
+    wall_clock_epoch = now;
+
+    struct tm local;
+    localtime_r(&now, &local);
+    if (local.tm_year < WALL_CLOCK_MIN_VALID_YEAR) {
+        if (!wall_clock_valid) return;
+        // Lost the time (clock reset): listeners drop their cached hour/minute
+        wall_clock_valid = false;
+        wall_clock = {};
+        wall_clock.tm_hour = -1;
+        wall_clock.tm_min = -1;
+        notify(minute_listeners, minute_listener_count);
+        notify(hour_listeners, hour_listener_count);
+        return;
+    }
+
+    const bool was_valid = wall_clock_valid;
+    const bool minute_changed = !was_valid || local.tm_min != wall_clock.tm_min ||
+                                local.tm_hour != wall_clock.tm_hour;
+    const bool hour_changed = !was_valid || local.tm_hour != wall_clock.tm_hour ||
+                              local.tm_mday != wall_clock.tm_mday;
+
+    wall_clock = local;
+    wall_clock_valid = true;
+
+    if (minute_changed) notify(minute_listeners, minute_listener_count);
+    if (hour_changed) notify(hour_listeners, hour_listener_count);
+}
+
+bool wallClockValid() {
+    return wall_clock_valid;
+}
+
+const struct tm& getWallClock() {
+    return wall_clock;
+}
+
+int wallClockHour() {
+    return wall_clock_valid ? wall_clock.tm_hour : -1;
+}
+
+int wallClockMinute() {
+    return wall_clock_valid ? wall_clock.tm_min : -1;
+}
+
+bool onWallClockMinute(WallClockListener listener) {
+    if (minute_listener_count >= WALL_CLOCK_MAX_LISTENERS) return false;
+    minute_listeners[minute_listener_count++] = listener;
+    return true;
+}
+
+bool onWallClockHour(WallClockListener listener) {
+    if (hour_listener_count >= WALL_CLOCK_MAX_LISTENERS) return false;
+    hour_listeners[hour_listener_count++] = listener;
+    return true;
+}
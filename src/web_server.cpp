@@ -1,10 +1,92 @@
 #include "web_server.h"
 #include "main_screen.h"
+#include "view_model.h"
+#include "lazy_screens.h"
+#include "lvgl_heap.h"
+#include "boot_timeline.h"
+#include "metrics_store.h"
+#include "wifi_manager.h"
+#include "network_recovery.h"
+#include "brightness_controller.h"
 #include <ArduinoJson.h>
+#include <esp_heap_caps.h>
 
 // Global instance
 PowerwallWebServer webServer;
 
+// /api/stats reads a copy the loop task publishes, not state it is changing
+#define STATS_SNAPSHOT_INTERVAL_MS 1000
+#define STATS_HOST_MAX 64
+
+struct StatsEndpoint {
+    char host[STATS_HOST_MAX];
+    uint16_t port;
+    uint32_t addr;  // 0 = not resolved
+    float latency_ms;
+    uint32_t connects;
+    uint32_t failures;
+};
+
+struct StatsSnapshot {
+    ViewStats view;
+    LazyScreenStats screens[LAZY_SCREEN_COUNT];
+    lvgl_heap_stats_t heap;
+    size_t free_internal;
+    WiFiStats wifi;
+    int mqtt_active;
+    MQTTBootstrapStats bootstrap;
+    MQTTIngestStats ingest;
+    uint8_t endpoint_count;
+    StatsEndpoint endpoints[MQTT_MAX_ENDPOINTS];
+    NetworkRecoveryStats recovery;
+    uint32_t first_frame_ms;
+    uint32_t ready_ms;
+    const char *metrics_source;
+    uint8_t stage_count;
+    BootStage stages[BOOT_TIMELINE_MAX_STAGES];
+};
+
+static portMUX_TYPE stats_mux = portMUX_INITIALIZER_UNLOCKED;
+static StatsSnapshot stats_published;  // Written by loop(), copied out under stats_mux
+static StatsSnapshot stats_building;   // Loop task only
+static StatsSnapshot stats_serving;    // Async TCP task only
+static unsigned long stats_published_at = 0;
+static volatile bool stats_reset_requested = false;
+
+static void buildStatsSnapshot(StatsSnapshot &snapshot) {
+    snapshot.view = getViewStats();
+    for (int i = 0; i < LAZY_SCREEN_COUNT; i++) {
+        snapshot.screens[i] = getLazyScreenStats((LazyScreenId)i);
+    }
+    lvgl_heap_get_stats(&snapshot.heap);
+    snapshot.free_internal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    snapshot.wifi = getWiFiStats();
+
+    snapshot.mqtt_active = mqttClient.getActiveEndpoint();
+    snapshot.bootstrap = mqttClient.getBootstrapStats();
+    snapshot.ingest = mqttClient.getIngestStats();
+    snapshot.endpoint_count = min(mqttClient.getEndpointCount(), (uint8_t)MQTT_MAX_ENDPOINTS);
+    for (uint8_t i = 0; i < snapshot.endpoint_count; i++) {
+        const MQTTEndpoint& endpoint = mqttClient.getEndpoint(i);
+        StatsEndpoint &entry = snapshot.endpoints[i];
+        strlcpy(entry.host, endpoint.host.c_str(), sizeof(entry.host));
+        entry.port = endpoint.port;
+        entry.addr = endpoint.resolved_at ? (uint32_t)endpoint.addr : 0;
+        entry.latency_ms = endpoint.latency_ms;
+        entry.connects = endpoint.connects;
+        entry.failures = endpoint.failures;
+    }
+
+    snapshot.recovery = getNetworkRecoveryStats();
+    snapshot.first_frame_ms = getBootFirstFrameMs();
+    snapshot.ready_ms = getBootReadyMs();
+    snapshot.metrics_source = getMetricsRestoreSource();
+    snapshot.stage_count = min(getBootStageCount(), (uint8_t)BOOT_TIMELINE_MAX_STAGES);
+    for (uint8_t i = 0; i < snapshot.stage_count; i++) {
+        snapshot.stages[i] = getBootStage(i);
+    }
+}
+
 PowerwallWebServer::PowerwallWebServer() : server(80) {
 }
 
@@ -14,6 +96,24 @@ void PowerwallWebServer::begin() {
     Serial.println("Web server started on port 80");
 }
 
+void PowerwallWebServer::loop() {
+    if (stats_reset_requested) {
+        stats_reset_requested = false;
+        mqttClient.resetIngestStats();
+        stats_published_at = 0;  // Show the reset right away
+    }
+
+    const unsigned long now = millis();
+    if (stats_published_at != 0 && now - stats_published_at < STATS_SNAPSHOT_INTERVAL_MS) return;
+    stats_published_at = now ? now : 1;
+
+    // Build outside the lock; only the copy is a critical section
+    buildStatsSnapshot(stats_building);
+    portENTER_CRITICAL(&stats_mux);
+    stats_published = stats_building;
+    portEXIT_CRITICAL(&stats_mux);
+}
+
 void PowerwallWebServer::setupRoutes() {
     // Root page - redirect to config
     server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
@@ -55,6 +155,24 @@ void PowerwallWebServer::setupRoutes() {
                 }
             }
             if (doc.containsKey("prefix")) config.topic_prefix = doc["prefix"].as<String>();
+            if (doc.containsKey("fallbacks")) config.fallback_brokers = doc["fallbacks"].as<String>();
+            if (doc.containsKey("wildcard")) config.wildcard_subscribe = doc["wildcard"].as<bool>();
+            if (doc.containsKey("filter")) config.subscribe_filter = doc["filter"].as<String>();
+            if (doc.containsKey("persistent")) config.clean_session = !doc["persistent"].as<bool>();
+            if (doc.containsKey("bootstrap")) config.bootstrap_prefix = doc["bootstrap"].as<String>();
+            if (doc.containsKey("maxRate")) config.max_rate = constrain(doc["maxRate"].as<int>(), 0, 1000);
+            if (doc.containsKey("evQos")) config.ev_qos = doc["evQos"].as<int>() > 0 ? 1 : 0;
+            // QoS: one value for every topic, or {"battery/level": 1, ...}
+            if (doc["qos"].is<JsonObject>()) {
+                for (JsonPair kv : doc["qos"].as<JsonObject>()) {
+                    PowerwallTopic topic = matchPowerwallTopic(kv.key().c_str());
+                    if (topic != TOPIC_UNKNOWN) config.topic_qos[topic] = kv.value().as<int>() > 0 ? 1 : 0;
+                }
+            } else if (doc.containsKey("qos")) {
+                const uint8_t qos = doc["qos"].as<int>() > 0 ? 1 : 0;
+                memset(config.topic_qos, qos, sizeof(config.topic_qos));
+                config.ev_qos = qos;
+            }
             
             // Save to flash and reconnect with new settings
             mqttClient.saveConfig();
@@ -67,14 +185,26 @@ void PowerwallWebServer::setupRoutes() {
     server.on("/api/mqtt", HTTP_GET, [](AsyncWebServerRequest *request) {
         MQTTConfig& config = mqttClient.getConfig();
 
-        StaticJsonDocument<512> doc;
+        StaticJsonDocument<1024> doc;
         doc["host"] = config.host;
         doc["port"] = config.port;
         doc["user"] = config.user;
         // Don't expose password in GET response for security
         doc["password"] = config.password.length() > 0 ? "********" : "";
         doc["prefix"] = config.topic_prefix;
+        doc["fallbacks"] = config.fallback_brokers;
+        doc["wildcard"] = config.wildcard_subscribe;
+        doc["filter"] = config.subscribe_filter;
+        doc["persistent"] = !config.clean_session;
+        doc["bootstrap"] = config.bootstrap_prefix;
+        doc["maxRate"] = config.max_rate;
+        doc["evQos"] = config.ev_qos;
+        JsonObject qos = doc.createNestedObject("qos");
+        for (uint8_t i = 0; i < TOPIC_COUNT; i++) {
+            qos[getPowerwallTopicSuffix((PowerwallTopic)i)] = config.topic_qos[i];
+        }
         doc["connected"] = mqttClient.isConnected();
+        doc["client_id"] = mqttClient.getClientId();
 
         String response;
         serializeJson(doc, response);
@@ -150,6 +280,12 @@ void PowerwallWebServer::setupRoutes() {
                 config.idleTimeout = BrightnessConfigManager::secondsToTimeout(timeout);
             }
             if (doc.containsKey("idleBrightness")) config.idleBrightness = doc["idleBrightness"].as<uint8_t>();
+            if (doc.containsKey("sleepMode")) {
+                int mode = doc["sleepMode"].as<int>();
+                config.sleepMode = (mode >= SLEEP_NEVER && mode <= SLEEP_ALWAYS) ? static_cast<SleepMode>(mode) : SLEEP_NEVER;
+            }
+            if (doc.containsKey("sleepTimeout")) config.sleepTimeout = doc["sleepTimeout"].as<uint16_t>();
+            if (doc.containsKey("wakeOnOffGrid")) config.wakeOnOffGrid = doc["wakeOnOffGrid"].as<bool>();
 
             brightnessConfig.saveConfig();
 
@@ -157,6 +293,17 @@ void PowerwallWebServer::setupRoutes() {
         }
     );
 
+    // Put the display to sleep / wake it (applied from the main loop)
+    server.on("/api/sleep", HTTP_POST, [](AsyncWebServerRequest *request) {
+        brightnessController.requestSleep();
+        request->send(200, "application/json", "{\"status\":\"ok\"}");
+    });
+
+    server.on("/api/wake", HTTP_POST, [](AsyncWebServerRequest *request) {
+        brightnessController.requestWake();
+        request->send(200, "application/json", "{\"status\":\"ok\"}");
+    });
+
     // API endpoint to get current brightness configuration
     server.on("/api/brightness", HTTP_GET, [](AsyncWebServerRequest *request) {
         BrightnessConfig& config = brightnessConfig.getConfig();
@@ -170,6 +317,10 @@ void PowerwallWebServer::setupRoutes() {
         doc["nightIdleDimmingEnabled"] = config.nightIdleDimmingEnabled;
         doc["idleTimeout"] = BrightnessConfigManager::timeoutToSeconds(config.idleTimeout);
         doc["idleBrightness"] = config.idleBrightness;
+        doc["sleepMode"] = static_cast<int>(config.sleepMode);
+        doc["sleepTimeout"] = config.sleepTimeout;
+        doc["wakeOnOffGrid"] = config.wakeOnOffGrid;
+        doc["asleep"] = brightnessController.isAsleep();
 
         String response;
         serializeJson(doc, response);
@@ -212,6 +363,17 @@ void PowerwallWebServer::setupRoutes() {
         doc["timezone"] = config.timezone;
         doc["ntpEnabled"] = config.ntpEnabled;
         doc["timeSynced"] = timeConfig.isTimeSynced();
+
+        const TimeSyncStats& sync = timeConfig.getSyncStats();
+        static const char *const sync_states[] = {"idle", "pending", "synced", "failed"};
+        JsonObject ntp = doc.createNestedObject("sync");
+        ntp["state"] = sync_states[sync.state];
+        ntp["syncs"] = sync.sync_count;
+        ntp["failures"] = sync.fail_count;
+        ntp["duration_ms"] = sync.last_duration_ms;
+        ntp["last_sync_age_s"] = sync.sync_count > 0 ? (millis() - sync.last_sync_ms) / 1000 : 0;
+        ntp["drift_ms"] = sync.last_drift_ms;
+        ntp["drift_ppm"] = sync.drift_ppm;
         
         // Get current time if available
         struct tm timeinfo;
@@ -226,6 +388,76 @@ void PowerwallWebServer::setupRoutes() {
         request->send(200, "application/json", response);
     });
 
+    // API endpoint to save network (static IP) configuration
+    server.on("/api/wifi", HTTP_POST, [](AsyncWebServerRequest *request) {}, NULL,
+        [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+            if (total > MAX_JSON_PAYLOAD_SIZE) {
+                request->send(413, "application/json", "{\"error\":\"Payload too large\"}");
+                return;
+            }
+
+            StaticJsonDocument<512> doc;
+            DeserializationError error = deserializeJson(doc, data, len);
+
+            if (error) {
+                request->send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+                return;
+            }
+
+            WiFiNetworkConfig& config = getWiFiNetworkConfig();
+            const bool static_ip = doc["staticIp"] | false;
+            if (static_ip) {
+                IPAddress ip, gateway, subnet, dns;
+                if (!ip.fromString(doc["ip"] | "") || !gateway.fromString(doc["gateway"] | "") ||
+                    !subnet.fromString(doc["subnet"] | "")) {
+                    request->send(400, "application/json", "{\"error\":\"Invalid address\"}");
+                    return;
+                }
+                if (!dns.fromString(doc["dns"] | "")) dns = gateway;
+                config.ip = ip;
+                config.gateway = gateway;
+                config.subnet = subnet;
+                config.dns = dns;
+            }
+            config.static_ip = static_ip;
+            saveWiFiNetworkConfig();
+
+            request->send(200, "application/json", "{\"status\":\"ok\"}");
+        }
+    );
+
+    // API endpoint to get network configuration and the cached connection details
+    server.on("/api/wifi", HTTP_GET, [](AsyncWebServerRequest *request) {
+        WiFiNetworkConfig& config = getWiFiNetworkConfig();
+        const WiFiConnectionCache& cache = getWiFiConnectionCache();
+
+        StaticJsonDocument<512> doc;
+        doc["staticIp"] = config.static_ip;
+        doc["ip"] = config.ip.toString();
+        doc["gateway"] = config.gateway.toString();
+        doc["subnet"] = config.subnet.toString();
+        doc["dns"] = config.dns.toString();
+
+        JsonObject cached = doc.createNestedObject("cache");
+        cached["valid"] = cache.valid;
+        if (cache.valid) {
+            char bssid[18];
+            snprintf(bssid, sizeof(bssid), "%02X:%02X:%02X:%02X:%02X:%02X",
+                     cache.bssid[0], cache.bssid[1], cache.bssid[2],
+                     cache.bssid[3], cache.bssid[4], cache.bssid[5]);
+            cached["bssid"] = bssid;
+            cached["channel"] = cache.channel;
+            cached["ip"] = cache.lease_ip.toString();
+            cached["gateway"] = cache.lease_gateway.toString();
+            cached["subnet"] = cache.lease_subnet.toString();
+            cached["dns"] = cache.lease_dns.toString();
+        }
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, "application/json", response);
+    });
+
     // API endpoint to save EV configuration
     server.on("/api/ev", HTTP_POST, [](AsyncWebServerRequest *request) {}, NULL,
         [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
@@ -234,7 +466,7 @@ void PowerwallWebServer::setupRoutes() {
                 return;
             }
 
-            StaticJsonDocument<512> doc;
+            StaticJsonDocument<MAX_JSON_PAYLOAD_SIZE> doc;
             DeserializationError error = deserializeJson(doc, data, len);
 
             if (error) {
@@ -249,13 +481,19 @@ void PowerwallWebServer::setupRoutes() {
             if (doc.containsKey("powerTopic")) config.ev_power_topic = doc["powerTopic"].as<String>();
             if (doc.containsKey("connectedTopic")) config.ev_connected_topic = doc["connectedTopic"].as<String>();
             if (doc.containsKey("socTopic")) config.ev_soc_topic = doc["socTopic"].as<String>();
+            const String previous_extra = config.extra_nodes;
+            if (doc.containsKey("extraNodes")) config.extra_nodes = doc["extraNodes"].as<String>();
 
             // Save config and update UI
             mqttClient.saveConfig();
             setEVEnabled(config.ev_enabled);
 
+            PowerNodeRole extra_roles[MQTT_MAX_EXTRA_NODES];
+            for (uint8_t i = 0; i < mqttClient.getExtraNodeCount(); i++) extra_roles[i] = mqttClient.getExtraNode(i).role;
+            configureExtraNodes(extra_roles, mqttClient.getExtraNodeCount());
+
             // If EV was just enabled or topics changed, reconnect MQTT to subscribe to new topics
-            if (config.ev_enabled && mqttClient.isConnected()) {
+            if ((config.ev_enabled || config.extra_nodes != previous_extra) && mqttClient.isConnected()) {
                 mqttClient.disconnect();
                 mqttClient.connect();
             }
@@ -268,11 +506,12 @@ void PowerwallWebServer::setupRoutes() {
     server.on("/api/ev", HTTP_GET, [](AsyncWebServerRequest *request) {
         MQTTConfig& config = mqttClient.getConfig();
 
-        StaticJsonDocument<512> doc;
+        StaticJsonDocument<768> doc;
         doc["enabled"] = config.ev_enabled;
         doc["powerTopic"] = config.ev_power_topic;
         doc["connectedTopic"] = config.ev_connected_topic;
         doc["socTopic"] = config.ev_soc_topic;
+        doc["extraNodes"] = config.extra_nodes;
 
         String response;
         serializeJson(doc, response);
@@ -326,6 +565,140 @@ void PowerwallWebServer::setupRoutes() {
         serializeJson(doc, response);
         request->send(200, "application/json", response);
     });
+
+    // API endpoint for UI/runtime statistics
+    // Counters as of the last loop() snapshot (at most STATS_SNAPSHOT_INTERVAL_MS old)
+    server.on("/api/stats", HTTP_GET, [](AsyncWebServerRequest *request) {
+        portENTER_CRITICAL(&stats_mux);
+        stats_serving = stats_published;
+        portEXIT_CRITICAL(&stats_mux);
+        const StatsSnapshot &snapshot = stats_serving;
+
+        // On the heap: the async TCP task has a small stack
+        DynamicJsonDocument doc(4096);
+        JsonObject ui = doc.createNestedObject("ui");
+        ui["updates_applied"] = snapshot.view.applied;
+        ui["updates_suppressed"] = snapshot.view.suppressed;
+
+        JsonArray screens = doc.createNestedArray("screens");
+        for (int i = 0; i < LAZY_SCREEN_COUNT; i++) {
+            const LazyScreenStats& stats = snapshot.screens[i];
+            JsonObject screen = screens.createNestedObject();
+            screen["name"] = stats.name;
+            screen["resident"] = stats.resident;
+            screen["created"] = stats.create_count;
+            screen["create_us"] = stats.last_create_us;
+            screen["lvgl_bytes"] = stats.last_mem_bytes;
+        }
+
+        const lvgl_heap_stats_t& heap = snapshot.heap;
+        JsonObject lvgl = doc.createNestedObject("lvgl_heap");
+        lvgl["total"] = heap.total_bytes;
+        lvgl["used"] = heap.used_bytes;
+        lvgl["free"] = heap.free_bytes;
+        lvgl["largest_free"] = heap.largest_free_block;
+        lvgl["min_free"] = heap.min_free_bytes;
+        lvgl["frag_pct"] = heap.frag_pct;
+        lvgl["fast_used"] = heap.fast_used_bytes;
+        lvgl["fast_free"] = heap.fast_free_bytes;
+        lvgl["allocs"] = heap.alloc_count;
+        lvgl["fast_allocs"] = heap.fast_alloc_count;
+        lvgl["overflows"] = heap.overflow_count;
+        lvgl["failures"] = heap.failure_count;
+        doc["free_internal"] = snapshot.free_internal;
+
+        const WiFiStats& wifi_stats = snapshot.wifi;
+        JsonObject wifi = doc.createNestedObject("wifi");
+        wifi["state"] = getWiFiStateName(wifi_stats.state);
+        wifi["attempts"] = wifi_stats.connect_attempts;
+        wifi["connects"] = wifi_stats.connects;
+        wifi["disconnects"] = wifi_stats.disconnects;
+        wifi["last_reason"] = wifi_stats.last_disconnect_reason;
+        wifi["associate_ms"] = wifi_stats.last_associate_ms;
+        wifi["dhcp_ms"] = wifi_stats.last_dhcp_ms;
+        wifi["reconnect_ms"] = wifi_stats.last_reconnect_ms;
+        wifi["fast_attempts"] = wifi_stats.fast_attempts;
+        wifi["fast_connects"] = wifi_stats.fast_connects;
+        wifi["lease_connects"] = wifi_stats.lease_connects;
+        wifi["uptime_s"] = wifi_stats.connected_since_ms ? (millis() - wifi_stats.connected_since_ms) / 1000 : 0;
+
+        JsonObject mqtt = doc.createNestedObject("mqtt");
+        mqtt["active"] = snapshot.mqtt_active;
+        const MQTTBootstrapStats& bootstrap_stats = snapshot.bootstrap;
+        mqtt["session_present"] = bootstrap_stats.session_present;
+        mqtt["resubscribed"] = bootstrap_stats.resubscribed;
+        mqtt["retained"] = bootstrap_stats.retained_received;
+        mqtt["companion_applied"] = bootstrap_stats.companion_applied;
+        mqtt["bootstrap_ms"] = bootstrap_stats.last_bootstrap_ms;
+        const MQTTIngestStats& ingest_stats = snapshot.ingest;
+        JsonObject ingest = mqtt.createNestedObject("ingest");
+        ingest["received"] = ingest_stats.received;
+        ingest["ignored"] = ingest_stats.ignored;
+        ingest["oversized"] = ingest_stats.oversized;
+        ingest["coalesced"] = ingest_stats.coalesced;
+        ingest["processed"] = ingest_stats.processed;
+        ingest["parse_errors"] = ingest_stats.parse_errors;
+        ingest["rate_limited"] = ingest_stats.rate_limited;
+        ingest["process_us_avg"] = ingest_stats.processed ? ingest_stats.process_us_total / ingest_stats.processed : 0;
+        ingest["process_us_max"] = ingest_stats.process_us_max;
+        JsonArray endpoints = mqtt.createNestedArray("endpoints");
+        for (uint8_t i = 0; i < snapshot.endpoint_count; i++) {
+            const StatsEndpoint& endpoint = snapshot.endpoints[i];
+            JsonObject entry = endpoints.createNestedObject();
+            entry["host"] = endpoint.host;
+            entry["port"] = endpoint.port;
+            entry["addr"] = endpoint.addr ? IPAddress(endpoint.addr).toString() : String("");
+            entry["latency_ms"] = endpoint.latency_ms;
+            entry["connects"] = endpoint.connects;
+            entry["failures"] = endpoint.failures;
+        }
+
+        const NetworkRecoveryStats& recovery_stats = snapshot.recovery;
+        JsonObject recovery = doc.createNestedObject("recovery");
+        recovery["in_outage"] = recovery_stats.in_outage;
+        recovery["step"] = getRecoveryStepName(recovery_stats.step);
+        recovery["outages"] = recovery_stats.outages;
+        recovery["last_outage_ms"] = recovery_stats.last_outage_ms;
+        recovery["longest_outage_ms"] = recovery_stats.longest_outage_ms;
+        recovery["reboots"] = recovery_stats.recovery_reboots;
+        JsonObject steps = recovery.createNestedObject("steps");
+        for (int i = 0; i < RECOVERY_STEP_COUNT; i++) {
+            const RecoveryStepStats& step_stats = recovery_stats.steps[i];
+            JsonObject step = steps.createNestedObject(getRecoveryStepName((RecoveryStep)i));
+            step["runs"] = step_stats.runs;
+            step["recoveries"] = step_stats.recoveries;
+            step["last_recovery_ms"] = step_stats.last_recovery_ms;
+        }
+
+        JsonObject boot = doc.createNestedObject("boot");
+        boot["first_frame_ms"] = snapshot.first_frame_ms;
+        boot["ready_ms"] = snapshot.ready_ms;
+        boot["metrics_source"] = snapshot.metrics_source;
+        JsonArray stages = boot.createNestedArray("stages");
+        for (uint8_t i = 0; i < snapshot.stage_count; i++) {
+            const BootStage& stage = snapshot.stages[i];
+            JsonObject entry = stages.createNestedObject();
+            entry["name"] = stage.name;
+            entry["end_ms"] = stage.end_ms;
+            entry["ms"] = stage.duration_ms;
+        }
+        doc["uptime_ms"] = millis();
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, "application/json", response);
+    });
+
+    // API endpoint to zero the MQTT ingest counters before a benchmark run
+    server.on("/api/stats/reset", HTTP_POST, [](AsyncWebServerRequest *request) {
+        stats_reset_requested = true;  // Counters belong to the loop task
+        request->send(200, "application/json", "{\"status\":\"ok\"}");
+    });
+}
+
+// Empty string for unset (0.0.0.0) addresses so the form shows placeholders
+static String ipOrBlank(const IPAddress &ip) {
+    return ip == IPAddress((uint32_t)0) ? String("") : ip.toString();
 }
 
 String PowerwallWebServer::getConfigPage() {
@@ -333,6 +706,7 @@ String PowerwallWebServer::getConfigPage() {
     DisplayConfig& dispConfig = displayConfig.getConfig();
     BrightnessConfig& brightConf = brightnessConfig.getConfig();
     TimeConfig& timeConf = timeConfig.getConfig();
+    WiFiNetworkConfig& netConf = getWiFiNetworkConfig();
     
     int currentRotation = DisplayConfigManager::rotationToDegrees(dispConfig.rotation);
 
@@ -552,6 +926,30 @@ String PowerwallWebServer::getConfigPage() {
                 <label for="idleBrightness">Idle Brightness: <span id="idleBrightnessValue" class="range-value">)rawliteral" + String(brightConf.idleBrightness) + R"rawliteral(%</span></label>
                 <input type="range" id="idleBrightness" name="idleBrightness" min="10" max="100" value=")rawliteral" + String(brightConf.idleBrightness) + R"rawliteral(" oninput="document.getElementById('idleBrightnessValue').textContent = this.value + '%'">
             </div>
+            <div class="form-group">
+                <label for="sleepMode">Display Sleep:</label>
+                <select id="sleepMode" name="sleepMode">
+                    <option value="0">Never</option>
+                    <option value="1">At night</option>
+                    <option value="2">Always</option>
+                </select>
+            </div>
+            <div class="form-group">
+                <label for="sleepTimeout">Sleep After:</label>
+                <select id="sleepTimeout" name="sleepTimeout">
+                    <option value="60">1 minute</option>
+                    <option value="300">5 minutes</option>
+                    <option value="900">15 minutes</option>
+                    <option value="1800">30 minutes</option>
+                    <option value="3600">60 minutes</option>
+                </select>
+            </div>
+            <div class="form-group">
+                <label>
+                    <input type="checkbox" id="wakeOnOffGrid" name="wakeOnOffGrid" )rawliteral" + String(brightConf.wakeOnOffGrid ? "checked" : "") + R"rawliteral(>
+                    Wake When Off-Grid
+                </label>
+            </div>
             <button type="submit" class="button">Save Brightness Settings</button>
         </form>
         <div class="status" id="brightnessStatus"></div>
@@ -587,6 +985,39 @@ String PowerwallWebServer::getConfigPage() {
         </div>
     </div>
 
+    <div class="container">
+        <h2 class="section-title">Network Settings</h2>
+        <form id="wifiForm">
+            <div class="form-group">
+                <label>
+                    <input type="checkbox" id="staticIp" name="staticIp" )rawliteral" + String(netConf.static_ip ? "checked" : "") + R"rawliteral(>
+                    Use Static IP (skips DHCP)
+                </label>
+            </div>
+            <div class="form-group">
+                <label for="ip">IP Address:</label>
+                <input type="text" id="ip" name="ip" value=")rawliteral" + ipOrBlank(netConf.ip) + R"rawliteral(" placeholder="192.168.1.50">
+            </div>
+            <div class="form-group">
+                <label for="gateway">Gateway:</label>
+                <input type="text" id="gateway" name="gateway" value=")rawliteral" + ipOrBlank(netConf.gateway) + R"rawliteral(" placeholder="192.168.1.1">
+            </div>
+            <div class="form-group">
+                <label for="subnet">Subnet Mask:</label>
+                <input type="text" id="subnet" name="subnet" value=")rawliteral" + ipOrBlank(netConf.subnet) + R"rawliteral(" placeholder="255.255.255.0">
+            </div>
+            <div class="form-group">
+                <label for="dns">DNS Server:</label>
+                <input type="text" id="dns" name="dns" value=")rawliteral" + ipOrBlank(netConf.dns) + R"rawliteral(" placeholder="Same as gateway">
+            </div>
+            <button type="submit" class="button">Save Network Settings</button>
+        </form>
+        <div class="status" id="wifiStatus"></div>
+        <div class="info">
+            <strong>Note:</strong> Applied on the next WiFi connection (restart the device to apply now).
+        </div>
+    </div>
+
     <div class="container">
         <h2 class="section-title">MQTT Settings</h2>
         <form id="mqttForm">
@@ -598,6 +1029,10 @@ String PowerwallWebServer::getConfigPage() {
                 <label for="port">MQTT Port:</label>
                 <input type="number" id="port" name="port" value=")rawliteral" + String(mqttConf.port) + R"rawliteral(" required>
             </div>
+            <div class="form-group">
+                <label for="fallbacks">Fallback Brokers (optional):</label>
+                <input type="text" id="fallbacks" name="fallbacks" value=")rawliteral" + mqttConf.fallback_brokers + R"rawliteral(" placeholder="192.168.1.11, mqtt2.local:1884">
+            </div>
             <div class="form-group">
                 <label for="user">MQTT Username:</label>
                 <input type="text" id="user" name="user" value=")rawliteral" + mqttConf.user + R"rawliteral(">
@@ -610,12 +1045,46 @@ String PowerwallWebServer::getConfigPage() {
                 <label for="prefix">Topic Prefix:</label>
                 <input type="text" id="prefix" name="prefix" value=")rawliteral" + mqttConf.topic_prefix + R"rawliteral(" placeholder="pypowerwall/" required>
             </div>
+            <div class="form-group">
+                <label>
+                    <input type="checkbox" id="wildcard" name="wildcard" )rawliteral" + String(mqttConf.wildcard_subscribe ? "checked" : "") + R"rawliteral(>
+                    Single Wildcard Subscription
+                </label>
+            </div>
+            <div class="form-group">
+                <label for="filter">Subscription Filter (optional):</label>
+                <input type="text" id="filter" name="filter" value=")rawliteral" + mqttConf.subscribe_filter + R"rawliteral(" placeholder="Topic prefix + #">
+            </div>
+            <div class="form-group">
+                <label>
+                    <input type="checkbox" id="persistent" name="persistent" )rawliteral" + String(mqttConf.clean_session ? "" : "checked") + R"rawliteral(>
+                    Persistent Session (broker keeps subscriptions while offline)
+                </label>
+            </div>
+            <div class="form-group">
+                <label for="qos">Subscription QoS:</label>
+                <select id="qos" name="qos">
+                    <option value="0" )rawliteral" + String(mqttConf.topic_qos[0] == 0 ? "selected" : "") + R"rawliteral(>0 - At most once</option>
+                    <option value="1" )rawliteral" + String(mqttConf.topic_qos[0] == 1 ? "selected" : "") + R"rawliteral(>1 - At least once</option>
+                </select>
+            </div>
+            <div class="form-group">
+                <label for="maxRate">Max Updates per Second (0 = unlimited):</label>
+                <input type="number" id="maxRate" name="maxRate" min="0" max="1000" value=")rawliteral" + String(mqttConf.max_rate) + R"rawliteral(">
+            </div>
+            <div class="form-group">
+                <label for="bootstrap">Bootstrap Topic Prefix (optional):</label>
+                <input type="text" id="bootstrap" name="bootstrap" value=")rawliteral" + mqttConf.bootstrap_prefix + R"rawliteral(" placeholder="powerwall-display/last/">
+            </div>
             <button type="submit" class="button">Save MQTT Settings</button>
         </form>
         <div class="status" id="mqttStatus"></div>
         <div class="info">
             <strong>Note:</strong> Topic prefix should match your pypowerwall MQTT configuration (default: "pypowerwall/").
             Device will automatically reconnect to MQTT broker after saving.
+            The wildcard subscription replaces the per-topic subscriptions with one; topics it brings in that the display doesn't use are ignored.
+            Retained values are shown as soon as the display connects. If pypowerwall doesn't retain its topics, set a bootstrap prefix: the display republishes the latest values there, retained, about once a minute.
+            Fallback brokers share the credentials and are used when the primary is unreachable; the fastest responding broker is preferred.
         </div>
     </div>
 
@@ -640,11 +1109,16 @@ String PowerwallWebServer::getConfigPage() {
                 <label for="evSOCTopic">EV Charge Level Topic (optional):</label>
                 <input type="text" id="evSOCTopic" name="evSOCTopic" value=")rawliteral" + mqttConf.ev_soc_topic + R"rawliteral(" placeholder="homeassistant/sensor/ev_battery/state">
             </div>
+            <div class="form-group">
+                <label for="extraNodes">Extra Flow Nodes (optional, up to 3):</label>
+                <input type="text" id="extraNodes" name="extraNodes" value=")rawliteral" + mqttConf.extra_nodes + R"rawliteral(" placeholder="generator:home/generator/power,ev:home/charger2/power">
+            </div>
             <button type="submit" class="button">Save EV Settings</button>
         </form>
         <div class="status" id="evStatus"></div>
         <div class="info">
             <strong>Note:</strong> EV power is assumed to be included in home/load readings. It will be subtracted from the displayed Home value to avoid double-counting. Use full MQTT topic paths (not using the prefix above).
+            Extra flow nodes are "role:topic" pairs with role generator, battery (positive = discharging) or ev (an additional charger, also subtracted from Home), shown as badges in the free corners.
         </div>
     </div>
 
@@ -665,6 +1139,8 @@ String PowerwallWebServer::getConfigPage() {
         // Set current values
         document.getElementById('rotation').value = ')rawliteral" + String(currentRotation) + R"rawliteral(';
         document.getElementById('idleTimeout').value = ')rawliteral" + String(BrightnessConfigManager::timeoutToSeconds(brightConf.idleTimeout)) + R"rawliteral(';
+        document.getElementById('sleepMode').value = ')rawliteral" + String(static_cast<int>(brightConf.sleepMode)) + R"rawliteral(';
+        document.getElementById('sleepTimeout').value = ')rawliteral" + String(brightConf.sleepTimeout) + R"rawliteral(';
 
         // Display settings form handler
         document.getElementById('displayForm').addEventListener('submit', async (e) => {
@@ -709,7 +1185,10 @@ String PowerwallWebServer::getConfigPage() {
                 dayIdleDimmingEnabled: document.getElementById('dayIdleDimmingEnabled').checked,
                 nightIdleDimmingEnabled: document.getElementById('nightIdleDimmingEnabled').checked,
                 idleTimeout: parseInt(formData.get('idleTimeout')),
-                idleBrightness: parseInt(formData.get('idleBrightness'))
+                idleBrightness: parseInt(formData.get('idleBrightness')),
+                sleepMode: parseInt(formData.get('sleepMode')),
+                sleepTimeout: parseInt(formData.get('sleepTimeout')),
+                wakeOnOffGrid: document.getElementById('wakeOnOffGrid').checked
             };
 
             const status = document.getElementById('brightnessStatus');
@@ -772,11 +1251,52 @@ String PowerwallWebServer::getConfigPage() {
             }
         });
 
+        // Network settings form handler
+        document.getElementById('wifiForm').addEventListener('submit', async (e) => {
+            e.preventDefault();
+            const formData = new FormData(e.target);
+            const data = {
+                staticIp: document.getElementById('staticIp').checked,
+                ip: formData.get('ip'),
+                gateway: formData.get('gateway'),
+                subnet: formData.get('subnet'),
+                dns: formData.get('dns')
+            };
+
+            const status = document.getElementById('wifiStatus');
+
+            try {
+                const response = await fetch('/api/wifi', {
+                    method: 'POST',
+                    headers: { 'Content-Type': 'application/json' },
+                    body: JSON.stringify(data)
+                });
+
+                if (response.ok) {
+                    status.className = 'status success';
+                    status.textContent = 'Network settings saved! They apply on the next connection.';
+                    status.style.display = 'block';
+                } else {
+                    status.className = 'status error';
+                    status.textContent = 'Failed to save network settings (check the addresses)';
+                    status.style.display = 'block';
+                }
+            } catch (error) {
+                status.className = 'status error';
+                status.textContent = 'Error: ' + error.message;
+                status.style.display = 'block';
+            }
+        });
+
         // MQTT settings form handler
         document.getElementById('mqttForm').addEventListener('submit', async (e) => {
             e.preventDefault();
             const formData = new FormData(e.target);
             const data = Object.fromEntries(formData.entries());
+            data.wildcard = document.getElementById('wildcard').checked;
+            data.persistent = document.getElementById('persistent').checked;
+            data.qos = parseInt(data.qos);
+            data.maxRate = parseInt(data.maxRate);
 
             const status = document.getElementById('mqttStatus');
 
@@ -811,7 +1331,8 @@ String PowerwallWebServer::getConfigPage() {
                 enabled: document.getElementById('evEnabled').checked,
                 powerTopic: formData.get('evPowerTopic'),
                 connectedTopic: formData.get('evConnectedTopic'),
-                socTopic: formData.get('evSOCTopic')
+                socTopic: formData.get('evSOCTopic'),
+                extraNodes: formData.get('extraNodes')
             };
 
             const status = document.getElementById('evStatus');
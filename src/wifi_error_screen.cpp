@@ -1,11 +1,10 @@
 #include "wifi_error_screen.h"
 #include "ui_assets/ui_assets.h"
-#include "improv_wifi.h"
+#include "wifi_manager.h"
+#include "ui_styles.h"
+#include "lazy_screens.h"
 
 // Theme colors
-#define COLOR_BG        0x0A0C10
-#define COLOR_WHITE     0xFFFFFF
-#define COLOR_GRAY      0x6A6A6A
 #define COLOR_BLUE      0x4FC3F7
 
 // WiFi error screen elements
@@ -27,10 +26,7 @@ void createWifiErrorScreen(lv_obj_t *parent_screen) {
     wifi_error_screen = lv_obj_create(parent_screen);
     lv_obj_set_size(wifi_error_screen, 480, 480);
     lv_obj_set_pos(wifi_error_screen, 0, 0);
-    lv_obj_set_style_bg_color(wifi_error_screen, lv_color_hex(COLOR_BG), 0);
-    lv_obj_set_style_bg_opa(wifi_error_screen, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_width(wifi_error_screen, 0, 0);
-    lv_obj_set_style_radius(wifi_error_screen, 0, 0);
+    lv_obj_add_style(wifi_error_screen, &ui_style_overlay, 0);
     lv_obj_clear_flag(wifi_error_screen, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_add_flag(wifi_error_screen, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
 
@@ -42,9 +38,7 @@ void createWifiErrorScreen(lv_obj_t *parent_screen) {
     // Error message label
     wifi_error_label = lv_label_create(wifi_error_screen);
     lv_label_set_text(wifi_error_label, "WiFi not configured");
-    lv_obj_set_style_text_color(wifi_error_label, lv_color_hex(COLOR_GRAY), 0);
-    lv_obj_set_style_text_font(wifi_error_label, &lv_font_montserrat_20, 0);
-    lv_obj_set_style_text_align(wifi_error_label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_add_style(wifi_error_label, &ui_style_message, 0);
     lv_obj_align(wifi_error_label, LV_ALIGN_CENTER, 0, 20);
 
     // Countdown/retry label (clickable)
@@ -60,7 +54,16 @@ void createWifiErrorScreen(lv_obj_t *parent_screen) {
     lv_obj_add_event_cb(wifi_countdown_label, retry_button_event_cb, LV_EVENT_CLICKED, NULL);
 }
 
+void destroyWifiErrorScreen() {
+    if (!wifi_error_screen) return;
+    lv_obj_del(wifi_error_screen);
+    wifi_error_screen = nullptr;
+    wifi_error_label = nullptr;
+    wifi_countdown_label = nullptr;
+}
+
 void showWifiErrorScreen(const char* message) {
+    ensureLazyScreen(LAZY_SCREEN_WIFI_ERROR);
     if (wifi_error_screen) {
         if (wifi_error_label && message) {
             lv_label_set_text(wifi_error_label, message);
@@ -97,7 +100,7 @@ void updateWifiErrorCountdown(unsigned long next_retry_time) {
     lv_obj_clear_flag(wifi_countdown_label, LV_OBJ_FLAG_HIDDEN);
 
     // If actively connecting, show connecting message instead of countdown
-    if (wifi_connecting) {
+    if (isWiFiConnecting()) {
         lv_label_set_text(wifi_countdown_label, "Connecting... (tap to retry)");
         return;
     }
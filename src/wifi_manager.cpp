@@ -0,0 +1,465 @@
+#include "wifi_manager.h"
+#include "wifi_error_screen.h"
+#include "mqtt_config_screen.h"
+#include "mqtt_client.h"
+#include "captive_portal.h"
+#include "web_server.h"
+#include <WiFi.h>
+#include <ESPmDNS.h>
+#include <esp_attr.h>
+
+#define MDNS_HOSTNAME "powerwall-display"
+
+// Event bits queued by the WiFi event task
+#define WIFI_EVT_CONNECTED    (1 << 0)
+#define WIFI_EVT_GOT_IP       (1 << 1)
+#define WIFI_EVT_DISCONNECTED (1 << 2)
+
+#define WIFI_LEASE_RTC_MAGIC 0x4C454153  // "LEAS"
+
+// Preferences for storing WiFi credentials
+Preferences wifi_preferences;
+
+// Cached-lease reuses since the last DHCP. Survives software resets but not
+// power loss, so a cold boot (the router may have rebooted too) always runs DHCP.
+struct RtcLease {
+    uint32_t magic;
+    uint32_t reuses;
+};
+RTC_NOINIT_ATTR static RtcLease rtc_lease;
+
+static portMUX_TYPE wifi_event_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t wifi_pending_events = 0;
+static uint8_t wifi_pending_reason = 0;
+static unsigned long wifi_evt_connected_ms = 0;
+static unsigned long wifi_evt_got_ip_ms = 0;
+static unsigned long wifi_evt_disconnected_ms = 0;
+
+static WiFiStats wifi_stats = {};
+static unsigned long wifi_attempt_start = 0;
+static unsigned long wifi_associated_at = 0;
+static unsigned long wifi_retry_at = 0;
+static unsigned long wifi_disconnected_time = 0;  // Start of the current outage, 0 while connected
+static bool wifi_web_server_started = false;
+
+static void (*wifi_result_callback)(bool connected) = nullptr;
+
+static WiFiNetworkConfig wifi_net_config;
+static WiFiConnectionCache wifi_cache;
+static bool wifi_fast_path_allowed = true;  // Cleared after a failed fast attempt
+
+// Cached so the error screen countdown doesn't hit NVS every frame (-1 = unknown)
+static int8_t wifi_has_credentials = -1;
+
+// Runs on the WiFi event task: only record, never touch LVGL or the network stack
+static void onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    portENTER_CRITICAL(&wifi_event_mux);
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+            wifi_pending_events |= WIFI_EVT_CONNECTED;
+            wifi_evt_connected_ms = millis();
+            break;
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            wifi_pending_events |= WIFI_EVT_GOT_IP;
+            wifi_evt_got_ip_ms = millis();
+            break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+            wifi_pending_events |= WIFI_EVT_DISCONNECTED;
+            wifi_pending_reason = info.wifi_sta_disconnected.reason;
+            wifi_evt_disconnected_ms = millis();
+            break;
+        default:
+            break;
+    }
+    portEXIT_CRITICAL(&wifi_event_mux);
+}
+
+static void loadNetworkSettings() {
+    wifi_preferences.begin("wifi", true);
+    wifi_net_config.static_ip = wifi_preferences.getBool("static_ip", false);
+    wifi_net_config.ip = IPAddress(wifi_preferences.getUInt("ip", 0));
+    wifi_net_config.gateway = IPAddress(wifi_preferences.getUInt("gateway", 0));
+    wifi_net_config.subnet = IPAddress(wifi_preferences.getUInt("subnet", 0));
+    wifi_net_config.dns = IPAddress(wifi_preferences.getUInt("dns", 0));
+
+    wifi_cache.valid = wifi_preferences.getBytes("bssid", wifi_cache.bssid, sizeof(wifi_cache.bssid)) == sizeof(wifi_cache.bssid);
+    wifi_cache.channel = wifi_preferences.getUChar("channel", 0);
+    wifi_cache.lease_ip = IPAddress(wifi_preferences.getUInt("lease_ip", 0));
+    wifi_cache.lease_gateway = IPAddress(wifi_preferences.getUInt("lease_gw", 0));
+    wifi_cache.lease_subnet = IPAddress(wifi_preferences.getUInt("lease_mask", 0));
+    wifi_cache.lease_dns = IPAddress(wifi_preferences.getUInt("lease_dns", 0));
+    wifi_preferences.end();
+
+    if (wifi_cache.channel == 0) wifi_cache.valid = false;
+}
+
+static bool staticAddressing() {
+    return wifi_net_config.static_ip && wifi_net_config.ip != IPAddress((uint32_t)0);
+}
+
+// Whether the fast path may skip DHCP with the cached lease
+static bool leaseReusable() {
+    return rtc_lease.magic == WIFI_LEASE_RTC_MAGIC && rtc_lease.reuses < WIFI_LEASE_MAX_REUSES &&
+           wifi_cache.lease_ip != IPAddress((uint32_t)0) && wifi_cache.lease_gateway != IPAddress((uint32_t)0) &&
+           wifi_cache.lease_subnet != IPAddress((uint32_t)0);
+}
+
+// Remember the AP and addressing of a successful connection (only writes NVS on change)
+static void updateConnectionCache() {
+    uint8_t *bssid = WiFi.BSSID();
+    const uint8_t channel = WiFi.channel();
+
+    // Only a DHCP result is a lease; static or reused addresses keep the cached one
+    const bool dhcp = !staticAddressing() && !wifi_stats.last_attempt_lease;
+    const IPAddress ip = dhcp ? WiFi.localIP() : wifi_cache.lease_ip;
+    const IPAddress gateway = dhcp ? WiFi.gatewayIP() : wifi_cache.lease_gateway;
+    const IPAddress subnet = dhcp ? WiFi.subnetMask() : wifi_cache.lease_subnet;
+    const IPAddress dns = dhcp ? WiFi.dnsIP() : wifi_cache.lease_dns;
+
+    if (!bssid) return;
+
+    if (wifi_cache.valid && memcmp(wifi_cache.bssid, bssid, 6) == 0 && wifi_cache.channel == channel &&
+        wifi_cache.lease_ip == ip && wifi_cache.lease_gateway == gateway &&
+        wifi_cache.lease_subnet == subnet && wifi_cache.lease_dns == dns) {
+        return;
+    }
+
+    memcpy(wifi_cache.bssid, bssid, 6);
+    wifi_cache.channel = channel;
+    wifi_cache.lease_ip = ip;
+    wifi_cache.lease_gateway = gateway;
+    wifi_cache.lease_subnet = subnet;
+    wifi_cache.lease_dns = dns;
+    wifi_cache.valid = true;
+
+    wifi_preferences.begin("wifi", false);
+    wifi_preferences.putBytes("bssid", wifi_cache.bssid, sizeof(wifi_cache.bssid));
+    wifi_preferences.putUChar("channel", channel);
+    wifi_preferences.putUInt("lease_ip", (uint32_t)ip);
+    wifi_preferences.putUInt("lease_gw", (uint32_t)gateway);
+    wifi_preferences.putUInt("lease_mask", (uint32_t)subnet);
+    wifi_preferences.putUInt("lease_dns", (uint32_t)dns);
+    wifi_preferences.end();
+    Serial.printf("WiFi: cached AP %02X:%02X:%02X:%02X:%02X:%02X on channel %u\n",
+                  bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], channel);
+}
+
+static void clearConnectionCache() {
+    wifi_cache = WiFiConnectionCache();
+    wifi_preferences.begin("wifi", false);
+    wifi_preferences.remove("bssid");
+    wifi_preferences.remove("channel");
+    wifi_preferences.remove("lease_ip");
+    wifi_preferences.remove("lease_gw");
+    wifi_preferences.remove("lease_mask");
+    wifi_preferences.remove("lease_dns");
+    wifi_preferences.end();
+}
+
+void setupWiFi() {
+    // Credentials live in our own namespace; don't let the driver rewrite its copy on every begin()
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+    // Retries are scheduled here, not by the Arduino auto-reconnect
+    WiFi.setAutoReconnect(false);
+    WiFi.onEvent(onWiFiEvent);
+    loadNetworkSettings();
+}
+
+void connectToWiFi(const char* ssid, const char* password) {
+    // Fast path: join the last AP directly on its channel, skipping the full scan,
+    // and reuse the cached lease instead of waiting for DHCP. A failed fast attempt
+    // retries with a scan and DHCP.
+    wifi_stats.last_attempt_fast = wifi_fast_path_allowed && wifi_cache.valid;
+    wifi_stats.last_attempt_lease = false;
+
+    if (staticAddressing()) {
+        WiFi.config(wifi_net_config.ip, wifi_net_config.gateway, wifi_net_config.subnet, wifi_net_config.dns);
+    } else if (wifi_stats.last_attempt_fast && leaseReusable()) {
+        WiFi.config(wifi_cache.lease_ip, wifi_cache.lease_gateway, wifi_cache.lease_subnet, wifi_cache.lease_dns);
+        wifi_stats.last_attempt_lease = true;
+        rtc_lease.reuses++;
+    } else {
+        WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);  // DHCP
+    }
+
+    if (wifi_stats.last_attempt_fast) {
+        wifi_stats.fast_attempts++;
+        WiFi.begin(ssid, password, wifi_cache.channel, wifi_cache.bssid);
+    } else {
+        WiFi.begin(ssid, password);
+    }
+
+    wifi_stats.state = WIFI_STATE_ASSOCIATING;
+    wifi_stats.connect_attempts++;
+    wifi_attempt_start = millis();
+    wifi_retry_at = 0;
+}
+
+bool loadWiFiCredentials(String &ssid, String &password) {
+    ssid = "";
+    password = "";
+    if (wifi_preferences.begin("wifi", true)) {  // Read-only
+        if (wifi_preferences.isKey("ssid")) {
+            ssid = wifi_preferences.getString("ssid", "");
+            password = wifi_preferences.getString("password", "");
+        }
+        wifi_preferences.end();
+    }
+    wifi_has_credentials = ssid.length() > 0 ? 1 : 0;
+    return wifi_has_credentials == 1;
+}
+
+void saveWiFiCredentials(const char *ssid, const char *password) {
+    wifi_preferences.begin("wifi", false);
+    wifi_preferences.putString("ssid", ssid);
+    wifi_preferences.putString("password", password);
+    wifi_preferences.end();
+    wifi_has_credentials = strlen(ssid) > 0 ? 1 : 0;
+
+    // The cached AP belongs to the old network
+    clearConnectionCache();
+}
+
+void retryWiFiConnection() {
+    String saved_ssid;
+    String saved_pass;
+    if (loadWiFiCredentials(saved_ssid, saved_pass)) {
+        Serial.println("Attempting to reconnect to WiFi...");
+        connectToWiFi(saved_ssid.c_str(), saved_pass.c_str());
+    }
+}
+
+void resetWiFiDriver() {
+    Serial.println("Resetting WiFi driver...");
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);  // Deinitializes the driver
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(false);
+
+    // The AP may have moved channel (router reboot), so scan
+    wifi_fast_path_allowed = false;
+    retryWiFiConnection();
+}
+
+static void scheduleRetry(unsigned long delay_ms) {
+    wifi_stats.state = WIFI_STATE_WAIT_RETRY;
+    wifi_retry_at = millis() + delay_ms;
+    if (wifi_retry_at == 0) wifi_retry_at = 1;  // 0 means "no retry scheduled"
+}
+
+// Helper function to handle successful WiFi connection
+static void onWiFiConnected() {
+    String ip = getLocalIP();
+    Serial.printf("WiFi connected! IP: %s\n", ip.c_str());
+
+    // Start mDNS responder
+    if (MDNS.begin(MDNS_HOSTNAME)) {
+        MDNS.addService("http", "tcp", 80);
+        Serial.printf("mDNS started: http://%s.local\n", MDNS_HOSTNAME);
+    } else {
+        Serial.println("mDNS failed to start");
+    }
+
+    // Hide the error screen
+    hideWifiErrorScreen();
+
+    // Stop captive portal if it was running
+    stopCaptivePortal();
+
+    // Routes are registered once; the server survives reconnects
+    if (!wifi_web_server_started) {
+        webServer.begin();
+        wifi_web_server_started = true;
+    }
+
+    // Check if MQTT is configured
+    MQTTConfig& mqtt_config = mqttClient.getConfig();
+    if (mqtt_config.host.length() > 0) {
+        // MQTT configured - connect to broker
+        hideMqttConfigScreen();
+        mqttClient.connect();
+    } else {
+        // MQTT not configured - show QR code to config page
+        showMqttConfigScreen(ip.c_str());
+        Serial.println("MQTT not configured - showing config screen");
+    }
+}
+
+static void onAttemptFailed(const char *message) {
+    Serial.printf("WiFi connection attempt failed (reason %u)\n", wifi_stats.last_disconnect_reason);
+
+    // A stale AP/channel cache shouldn't cost a retry delay: rescan right away
+    if (wifi_stats.last_attempt_fast) {
+        Serial.println("WiFi fast connect failed, falling back to a full scan");
+        wifi_fast_path_allowed = false;
+        retryWiFiConnection();
+        return;
+    }
+
+    showWifiErrorScreen(message);
+    scheduleRetry(WIFI_RECONNECT_DELAY);
+    if (wifi_result_callback) wifi_result_callback(false);
+}
+
+static void handleConnected(unsigned long at) {
+    if (wifi_stats.state != WIFI_STATE_ASSOCIATING) return;
+    wifi_stats.last_associate_ms = at - wifi_attempt_start;
+    wifi_associated_at = at;
+    wifi_stats.state = WIFI_STATE_DHCP;
+}
+
+static void handleGotIP(unsigned long at) {
+    if (wifi_stats.state == WIFI_STATE_CONNECTED) return;
+    wifi_stats.last_dhcp_ms = wifi_associated_at ? at - wifi_associated_at : 0;
+    if (wifi_disconnected_time > 0) {
+        wifi_stats.last_reconnect_ms = at - wifi_disconnected_time;
+        Serial.printf("WiFi reconnected after %lu ms\n", (unsigned long)wifi_stats.last_reconnect_ms);
+    }
+    Serial.printf("WiFi timing: associate %lu ms, DHCP %lu ms\n",
+                  (unsigned long)wifi_stats.last_associate_ms, (unsigned long)wifi_stats.last_dhcp_ms);
+
+    wifi_stats.state = WIFI_STATE_CONNECTED;
+    wifi_stats.connects++;
+    if (wifi_stats.last_attempt_fast) wifi_stats.fast_connects++;
+    if (wifi_stats.last_attempt_lease) wifi_stats.lease_connects++;
+    if (!staticAddressing() && !wifi_stats.last_attempt_lease) {
+        // Fresh DHCP lease: it may be reused again
+        rtc_lease.magic = WIFI_LEASE_RTC_MAGIC;
+        rtc_lease.reuses = 0;
+    }
+    wifi_fast_path_allowed = true;
+    updateConnectionCache();
+    wifi_stats.connected_since_ms = at;
+    wifi_disconnected_time = 0;
+    wifi_retry_at = 0;
+
+    onWiFiConnected();
+    if (wifi_result_callback) wifi_result_callback(true);
+}
+
+static void handleDisconnected(uint8_t reason, unsigned long at) {
+    wifi_stats.last_disconnect_reason = reason;
+
+    switch (wifi_stats.state) {
+        case WIFI_STATE_CONNECTED:
+            wifi_stats.disconnects++;
+            wifi_stats.connected_since_ms = 0;
+            wifi_disconnected_time = at;
+            Serial.printf("WiFi disconnected (reason %u)! Showing error screen...\n", reason);
+
+            // Disconnect MQTT since WiFi is lost
+            mqttClient.disconnect();
+            showWifiErrorScreen("WiFi connection lost\nRetrying...");
+
+            // First retry right away, later ones are spaced out
+            retryWiFiConnection();
+            break;
+
+        case WIFI_STATE_ASSOCIATING:
+        case WIFI_STATE_DHCP:
+            // Our own begin() tears down the previous association first
+            if (reason == WIFI_REASON_ASSOC_LEAVE) break;
+            onAttemptFailed(wifi_disconnected_time > 0 ? "WiFi connection lost\nRetrying..."
+                                                       : "Connection failed\nRetrying...");
+            break;
+
+        default:
+            break;
+    }
+}
+
+void checkWiFiConnection() {
+    // Drain events queued by the WiFi task
+    portENTER_CRITICAL(&wifi_event_mux);
+    const uint8_t events = wifi_pending_events;
+    const uint8_t reason = wifi_pending_reason;
+    const unsigned long connected_at = wifi_evt_connected_ms;
+    const unsigned long got_ip_at = wifi_evt_got_ip_ms;
+    const unsigned long disconnected_at = wifi_evt_disconnected_ms;
+    wifi_pending_events = 0;
+    portEXIT_CRITICAL(&wifi_event_mux);
+
+    if (events & WIFI_EVT_DISCONNECTED) handleDisconnected(reason, disconnected_at);
+    if (events & WIFI_EVT_CONNECTED) handleConnected(connected_at);
+    if (events & WIFI_EVT_GOT_IP) handleGotIP(got_ip_at);
+
+    const unsigned long now = millis();
+
+    // Attempt timeout (association or DHCP never completed)
+    const unsigned long attempt_timeout = wifi_stats.last_attempt_fast ? WIFI_FAST_CONNECT_TIMEOUT : WIFI_CONNECT_TIMEOUT;
+    if ((wifi_stats.state == WIFI_STATE_ASSOCIATING || wifi_stats.state == WIFI_STATE_DHCP) &&
+        now - wifi_attempt_start > attempt_timeout) {
+        Serial.println("WiFi connection timeout");
+        WiFi.disconnect();
+        onAttemptFailed(wifi_disconnected_time > 0 ? "WiFi connection lost\nRetrying..."
+                                                   : "Connection failed\nRetrying...");
+    }
+
+    // Scheduled retry
+    if (wifi_stats.state == WIFI_STATE_WAIT_RETRY && wifi_retry_at != 0 &&
+        (long)(now - wifi_retry_at) >= 0) {
+        retryWiFiConnection();
+    }
+}
+
+String getLocalIP() {
+    if (wifi_stats.state == WIFI_STATE_CONNECTED) {
+        return WiFi.localIP().toString();
+    }
+    return "";
+}
+
+unsigned long getNextWiFiRetryTime() {
+    return wifi_stats.state == WIFI_STATE_WAIT_RETRY ? wifi_retry_at : 0;
+}
+
+bool hasWifiCredentials() {
+    if (wifi_has_credentials < 0) {
+        String ssid;
+        String password;
+        loadWiFiCredentials(ssid, password);
+    }
+    return wifi_has_credentials == 1;
+}
+
+WiFiNetworkConfig& getWiFiNetworkConfig() {
+    return wifi_net_config;
+}
+
+void saveWiFiNetworkConfig() {
+    wifi_preferences.begin("wifi", false);
+    wifi_preferences.putBool("static_ip", wifi_net_config.static_ip);
+    wifi_preferences.putUInt("ip", (uint32_t)wifi_net_config.ip);
+    wifi_preferences.putUInt("gateway", (uint32_t)wifi_net_config.gateway);
+    wifi_preferences.putUInt("subnet", (uint32_t)wifi_net_config.subnet);
+    wifi_preferences.putUInt("dns", (uint32_t)wifi_net_config.dns);
+    wifi_preferences.end();
+}
+
+const WiFiConnectionCache& getWiFiConnectionCache() {
+    return wifi_cache;
+}
+
+bool isWiFiConnecting() {
+    return wifi_stats.state == WIFI_STATE_ASSOCIATING || wifi_stats.state == WIFI_STATE_DHCP;
+}
+
+const WiFiStats& getWiFiStats() {
+    return wifi_stats;
+}
+
+const char* getWiFiStateName(WiFiState state) {
+    switch (state) {
+        case WIFI_STATE_IDLE:        return "idle";
+        case WIFI_STATE_ASSOCIATING: return "associating";
+        case WIFI_STATE_DHCP:        return "dhcp";
+        case WIFI_STATE_CONNECTED:   return "connected";
+        case WIFI_STATE_WAIT_RETRY:  return "wait_retry";
+        default:                     return "unknown";
+    }
+}
+
+void setWiFiResultCallback(void (*callback)(bool connected)) {
+    wifi_result_callback = callback;
+}
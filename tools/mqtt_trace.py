@@ -0,0 +1,302 @@
+#!/usr/bin/env python3
+"""
+Record, replay and generate MQTT traffic for load-testing the display
+
+Records real pypowerwall traffic to a JSON-lines trace, replays it against a
+(local) broker at any speed, and generates synthetic patterns. Use it with the
+device's /api/stats ingest counters to benchmark the parse/dispatch/UI path.
+
+Requirements:
+    pip3 install paho-mqtt
+
+Usage:
+    python3 mqtt_trace.py record   --broker HOST [--prefix pypowerwall/] [--duration S] trace.jsonl
+    python3 mqtt_trace.py replay   --broker HOST [--speed 1|10|1000] [--loop N] trace.jsonl
+    python3 mqtt_trace.py generate --broker HOST --pattern steady|burst|oversized|noise|storm
+                                   [--rate MSG/S] [--duration S] [--client-id DEVICE_ID]
+    python3 mqtt_trace.py stats    --device IP [--reset] [--watch S]
+
+Example (10x replay while watching the device):
+    python3 tools/mqtt_trace.py stats --device 192.168.1.50 --reset
+    python3 tools/mqtt_trace.py replay --broker localhost --speed 10 traces/day.jsonl
+    python3 tools/mqtt_trace.py stats --device 192.168.1.50
+
+Patterns:
+    steady     realistic values for every pypowerwall topic at --rate
+    burst      the same, in bursts of --burst messages with idle gaps
+    oversized  payloads larger than the device accepts (must be dropped cheaply)
+    noise      unrelated topics under the prefix (wildcard mode must ignore them)
+    storm      connect with the device's client id over and over; the broker kicks
+               the device each time, exercising its reconnect and bootstrap path
+"""
+
+import argparse
+import base64
+import json
+import math
+import random
+import sys
+import time
+import urllib.request
+
+import paho.mqtt.client as mqtt
+
+TOPICS = [
+    "solar/instant_power",
+    "site/instant_power",
+    "load/instant_power",
+    "battery/instant_power",
+    "battery/level",
+    "site/offgrid",
+    "battery/time_remaining",
+]
+
+
+def make_client(client_id=""):
+    """paho-mqtt 1.x and 2.x compatible client"""
+    try:
+        return mqtt.Client(mqtt.CallbackAPIVersion.VERSION1, client_id=client_id)
+    except AttributeError:
+        return mqtt.Client(client_id=client_id)
+
+
+def connect(args, client_id=""):
+    client = make_client(client_id)
+    if args.user:
+        client.username_pw_set(args.user, args.password)
+    client.connect(args.broker, args.port, keepalive=30)
+    client.loop_start()
+    return client
+
+
+def encode_payload(payload):
+    try:
+        return {"payload": payload.decode("utf-8")}
+    except UnicodeDecodeError:
+        return {"payload_b64": base64.b64encode(payload).decode("ascii")}
+
+
+def decode_payload(entry):
+    if "payload_b64" in entry:
+        return base64.b64decode(entry["payload_b64"])
+    return entry["payload"].encode("utf-8")
+
+
+def cmd_record(args):
+    out = open(args.trace, "w")
+    start = time.monotonic()
+    count = 0
+
+    def on_message(client, userdata, msg):
+        nonlocal count
+        entry = {"t": round(time.monotonic() - start, 4), "topic": msg.topic,
+                 "qos": msg.qos, "retain": bool(msg.retain)}
+        entry.update(encode_payload(msg.payload))
+        out.write(json.dumps(entry) + "\n")
+        count += 1
+
+    client = make_client()
+    if args.user:
+        client.username_pw_set(args.user, args.password)
+    client.on_message = on_message
+    client.connect(args.broker, args.port, keepalive=30)
+    client.subscribe(args.prefix + "#")
+    for topic in args.extra_topic or []:
+        client.subscribe(topic)
+    client.loop_start()
+
+    print(f"Recording {args.prefix}# to {args.trace} (Ctrl-C to stop)")
+    try:
+        while args.duration <= 0 or time.monotonic() - start < args.duration:
+            time.sleep(0.5)
+    except KeyboardInterrupt:
+        pass
+    client.loop_stop()
+    client.disconnect()
+    out.close()
+    print(f"Recorded {count} messages in {time.monotonic() - start:.1f} s")
+
+
+def cmd_replay(args):
+    entries = []
+    with open(args.trace) as f:
+        for line in f:
+            line = line.strip()
+            if line:
+                entries.append(json.loads(line))
+    if not entries:
+        sys.exit("Trace is empty")
+
+    client = connect(args)
+    sent = 0
+    start = time.monotonic()
+    for _ in range(max(1, args.loop)):
+        base = time.monotonic()
+        for entry in entries:
+            topic = entry["topic"]
+            if args.prefix is not None and args.source_prefix and topic.startswith(args.source_prefix):
+                topic = args.prefix + topic[len(args.source_prefix):]
+            delay = entry["t"] / args.speed - (time.monotonic() - base)
+            if delay > 0:
+                time.sleep(delay)
+            client.publish(topic, decode_payload(entry), qos=entry.get("qos", 0),
+                           retain=entry.get("retain", False) and not args.no_retain)
+            sent += 1
+    elapsed = time.monotonic() - start
+    client.loop_stop()
+    client.disconnect()
+    print(f"Replayed {sent} messages in {elapsed:.2f} s ({sent / max(elapsed, 1e-6):.0f} msg/s, {args.speed}x)")
+
+
+def synthetic_value(topic, t):
+    """Plausible pypowerwall values that change over time"""
+    solar = max(0.0, 6000 * math.sin(t / 60.0)) + random.uniform(-50, 50)
+    load = 1500 + 800 * math.sin(t / 7.0) + random.uniform(-100, 100)
+    battery = (load - solar) * 0.6
+    values = {
+        "solar/instant_power": solar,
+        "load/instant_power": load,
+        "battery/instant_power": battery,
+        "site/instant_power": load - solar - battery,
+        "battery/level": 50 + 40 * math.sin(t / 300.0),
+        "site/offgrid": 0,
+        "battery/time_remaining": 12.5,
+    }
+    value = values[topic]
+    return str(int(value)) if topic == "site/offgrid" else f"{value:.1f}"
+
+
+def cmd_generate(args):
+    if args.pattern == "storm":
+        return run_storm(args)
+
+    client = connect(args)
+    interval = 1.0 / args.rate if args.rate > 0 else 0
+    start = time.monotonic()
+    next_send = start
+    sent = 0
+    i = 0
+    while time.monotonic() - start < args.duration:
+        t = time.monotonic() - start
+        topic = TOPICS[i % len(TOPICS)]
+        if args.pattern == "oversized":
+            payload = "9" * args.size
+        elif args.pattern == "noise":
+            topic = f"noise/{i % 500}/value"
+            payload = str(i)
+        else:
+            payload = synthetic_value(topic, t)
+        client.publish(args.prefix + topic, payload, qos=args.qos)
+        sent += 1
+        i += 1
+
+        if args.pattern == "burst" and i % args.burst == 0:
+            time.sleep(args.gap)
+            next_send = time.monotonic()
+        elif interval:
+            next_send += interval
+            delay = next_send - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+    elapsed = time.monotonic() - start
+    client.loop_stop()
+    client.disconnect()
+    print(f"Sent {sent} '{args.pattern}' messages in {elapsed:.2f} s ({sent / max(elapsed, 1e-6):.0f} msg/s)")
+
+
+def run_storm(args):
+    if not args.client_id:
+        sys.exit("storm needs --client-id (shown as client_id by GET /api/mqtt on the device)")
+    kicks = 0
+    start = time.monotonic()
+    while time.monotonic() - start < args.duration:
+        client = connect(args, args.client_id)
+        time.sleep(0.2)
+        client.loop_stop()
+        client.disconnect()
+        kicks += 1
+        time.sleep(args.gap)
+    print(f"Kicked the device {kicks} times in {time.monotonic() - start:.1f} s")
+
+
+def fetch_json(url, data=None):
+    request = urllib.request.Request(url, data=data, method="POST" if data is not None else "GET")
+    with urllib.request.urlopen(request, timeout=5) as response:
+        return json.loads(response.read().decode("utf-8"))
+
+
+def cmd_stats(args):
+    base = f"http://{args.device}"
+    if args.reset:
+        fetch_json(base + "/api/stats/reset", data=b"")
+        print("Device counters reset")
+        return
+
+    previous = None
+    while True:
+        stats = fetch_json(base + "/api/stats")
+        mqtt_stats = stats.get("mqtt", {})
+        ingest = mqtt_stats.get("ingest", {})
+        line = ", ".join(f"{k} {v}" for k, v in ingest.items())
+        if previous is not None and args.watch:
+            rate = (ingest.get("processed", 0) - previous) / args.watch
+            line += f" | processed {rate:.0f}/s"
+        print(f"ingest: {line}")
+        print(f"bootstrap_ms {mqtt_stats.get('bootstrap_ms')}, free_internal {stats.get('free_internal')}")
+        if not args.watch:
+            break
+        previous = ingest.get("processed", 0)
+        time.sleep(args.watch)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="MQTT trace record/replay and load generator")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    def broker_args(p):
+        p.add_argument("--broker", default="localhost")
+        p.add_argument("--port", type=int, default=1883)
+        p.add_argument("--user")
+        p.add_argument("--password")
+        p.add_argument("--prefix", default="pypowerwall/")
+
+    p = sub.add_parser("record", help="record live traffic to a trace file")
+    broker_args(p)
+    p.add_argument("--duration", type=float, default=0, help="seconds, 0 = until Ctrl-C")
+    p.add_argument("--extra-topic", action="append", help="also record this topic (e.g. EV)")
+    p.add_argument("trace")
+    p.set_defaults(func=cmd_record)
+
+    p = sub.add_parser("replay", help="replay a trace file")
+    broker_args(p)
+    p.add_argument("--speed", type=float, default=1.0, help="1, 10, 1000 ...")
+    p.add_argument("--loop", type=int, default=1)
+    p.add_argument("--source-prefix", help="rewrite this recorded prefix to --prefix")
+    p.add_argument("--no-retain", action="store_true")
+    p.add_argument("trace")
+    p.set_defaults(func=cmd_replay)
+
+    p = sub.add_parser("generate", help="generate synthetic traffic")
+    broker_args(p)
+    p.add_argument("--pattern", choices=["steady", "burst", "oversized", "noise", "storm"], default="steady")
+    p.add_argument("--rate", type=float, default=100, help="messages/s, 0 = as fast as possible")
+    p.add_argument("--duration", type=float, default=10)
+    p.add_argument("--burst", type=int, default=1000, help="messages per burst")
+    p.add_argument("--gap", type=float, default=1.0, help="seconds between bursts / storm kicks")
+    p.add_argument("--size", type=int, default=4096, help="oversized payload bytes")
+    p.add_argument("--qos", type=int, default=0, choices=[0, 1])
+    p.add_argument("--client-id", help="device client id (storm)")
+    p.set_defaults(func=cmd_generate)
+
+    p = sub.add_parser("stats", help="show or reset the device ingest counters")
+    p.add_argument("--device", required=True, help="device IP or hostname")
+    p.add_argument("--reset", action="store_true")
+    p.add_argument("--watch", type=float, default=0, help="poll every N seconds")
+    p.set_defaults(func=cmd_stats)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""
+Golden-image rendering regression check for the dashboard
+
+Runs the native build (pio run -e native) through its fixed metric scenes
+(zero data, solar export, off-grid, EV charging, battery full), compares each
+framebuffer with the stored golden PNG within a tolerance and checks the
+per-scene render time against the golden timings.
+
+Requirements:
+    PlatformIO (for --build); Python 3 standard library only
+
+Usage:
+    python3 render_regression.py [--build] [--update] [--golden DIR] [--out DIR]
+                                 [--threshold N] [--tolerance FRACTION] [--time-slack FACTOR]
+                                 [--no-timing]
+    python3 render_regression.py --build --against REV
+
+Example (after a layout change):
+    python3 tools/render_regression.py --build           # fails, diffs in render_out/
+    python3 tools/render_regression.py --update          # accept the new images
+
+Example (no golden set yet, or reviewing a branch):
+    python3 tools/render_regression.py --build --against main
+
+--against builds REV in a temporary git worktree and uses its scenes as the
+golden set, rendered on this machine (so its timings are comparable too).
+
+Scenes render in sequence on one dashboard; regenerate the golden set together.
+Render time depends on the host, so compare timings produced on the same machine
+(CI uses --no-timing and checks the images only).
+"""
+
+import argparse
+import json
+import os
+import shutil
+import struct
+import subprocess
+import sys
+import zlib
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_BINARY = os.path.join(REPO, ".pio", "build", "native", "program")
+DEFAULT_GOLDEN = os.path.join(REPO, "tools", "render_golden")
+
+
+def read_png(path):
+    """8-bit RGB/RGBA PNG -> (width, height, rows of RGB bytes)"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError(f"{path}: not a PNG")
+    pos, idat = 8, b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+            if depth != 8 or color not in (2, 6) or interlace:
+                raise ValueError(f"{path}: only 8-bit RGB/RGBA non-interlaced PNGs are supported")
+            bpp = 3 if color == 2 else 4
+        elif kind == b"IDAT":
+            idat += body
+        pos += 12 + length
+
+    raw = zlib.decompress(idat)
+    stride = width * bpp
+    rows, prev = [], bytearray(stride)
+    for y in range(height):
+        start = y * (stride + 1)
+        kind, line = raw[start], bytearray(raw[start + 1:start + 1 + stride])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        prev = line
+        rows.append(bytes(line) if bpp == 3 else bytes(v for j, v in enumerate(line) if j % 4 != 3))
+    return width, height, rows
+
+
+def write_png(path, width, height, rows):
+    def chunk(kind, body):
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", zlib.crc32(kind + body))
+
+    raw = b"".join(b"\x00" + row for row in rows)
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(raw, 6)))
+        f.write(chunk(b"IEND", b""))
+
+
+def compare(golden, actual, threshold):
+    """Count pixels whose largest channel difference exceeds threshold; returns (count, diff rows)"""
+    gw, gh, grows = golden
+    aw, ah, arows = actual
+    if (gw, gh) != (aw, ah):
+        return None, None
+    bad, diff_rows = 0, []
+    for grow, arow in zip(grows, arows):
+        out = bytearray(len(arow))
+        for x in range(0, len(arow), 3):
+            delta = max(abs(grow[x] - arow[x]), abs(grow[x + 1] - arow[x + 1]), abs(grow[x + 2] - arow[x + 2]))
+            if delta > threshold:
+                bad += 1
+                out[x] = 255  # Red where it differs, dimmed frame elsewhere
+            else:
+                out[x] = out[x + 1] = out[x + 2] = arow[x + 1] // 4
+        diff_rows.append(bytes(out))
+    return bad, diff_rows
+
+
+def run_scenes(binary, out, scene_frames):
+    if not os.path.exists(binary):
+        sys.exit(f"{binary} not found (run with --build or pio run -e native)")
+    os.makedirs(out, exist_ok=True)
+    subprocess.run([binary, "--scenes", out, "--scene-frames", str(scene_frames)], check=True)
+    with open(os.path.join(out, "timings.json")) as f:
+        return json.load(f)
+
+
+def render_baseline(rev, out, scene_frames):
+    """Build REV in a temporary worktree and render its scenes into out"""
+    worktree = os.path.join(out, "worktree")
+    if os.path.exists(worktree):
+        subprocess.run(["git", "worktree", "remove", "--force", worktree], cwd=REPO)
+    subprocess.run(["git", "worktree", "add", "--detach", worktree, rev], cwd=REPO, check=True)
+    try:
+        subprocess.run(["pio", "run", "-e", "native"], cwd=worktree, check=True)
+        run_scenes(os.path.join(worktree, ".pio", "build", "native", "program"), out, scene_frames)
+    finally:
+        subprocess.run(["git", "worktree", "remove", "--force", worktree], cwd=REPO)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Dashboard golden-image and render-time regression check")
+    parser.add_argument("--binary", default=DEFAULT_BINARY)
+    parser.add_argument("--golden", default=DEFAULT_GOLDEN)
+    parser.add_argument("--out", default=os.path.join(REPO, "render_out"))
+    parser.add_argument("--build", action="store_true", help="pio run -e native first")
+    parser.add_argument("--update", action="store_true", help="replace the golden images and timings")
+    parser.add_argument("--against", metavar="REV", help="render REV (git revision) as the golden set")
+    parser.add_argument("--scene-frames", type=int, default=30)
+    parser.add_argument("--threshold", type=int, default=8, help="per-channel difference ignored (0-255)")
+    parser.add_argument("--tolerance", type=float, default=0.001, help="fraction of pixels allowed to differ")
+    parser.add_argument("--time-slack", type=float, default=1.5, help="allowed render time vs golden")
+    parser.add_argument("--no-timing", action="store_true", help="compare images only (golden timings from another host)")
+    args = parser.parse_args()
+
+    if args.update and args.against:
+        sys.exit("--update and --against are exclusive")
+    if args.build:
+        subprocess.run(["pio", "run", "-e", "native"], cwd=REPO, check=True)
+    timings = run_scenes(args.binary, args.out, args.scene_frames)
+
+    if args.against:
+        args.golden = os.path.join(args.out, "baseline")
+        render_baseline(args.against, args.golden, args.scene_frames)
+
+    if args.update:
+        os.makedirs(args.golden, exist_ok=True)
+        for scene in timings:
+            shutil.copy(os.path.join(args.out, scene + ".png"), args.golden)
+        shutil.copy(os.path.join(args.out, "timings.json"), args.golden)
+        print(f"Updated {len(timings)} golden scenes in {args.golden}")
+        return
+
+    golden_timings_path = os.path.join(args.golden, "timings.json")
+    golden_timings = {}
+    if os.path.exists(golden_timings_path):
+        with open(golden_timings_path) as f:
+            golden_timings = json.load(f)
+
+    failed = 0
+    for scene, timing in timings.items():
+        golden_path = os.path.join(args.golden, scene + ".png")
+        if not os.path.exists(golden_path):
+            print(f"FAIL {scene}: no golden image (run with --update, or compare with --against REV)")
+            failed += 1
+            continue
+
+        actual = read_png(os.path.join(args.out, scene + ".png"))
+        bad, diff_rows = compare(read_png(golden_path), actual, args.threshold)
+        problems = []
+        if bad is None:
+            problems.append("size differs from golden")
+        else:
+            total = actual[0] * actual[1]
+            if bad > total * args.tolerance:
+                diff_path = os.path.join(args.out, scene + "_diff.png")
+                write_png(diff_path, actual[0], actual[1], diff_rows)
+                problems.append(f"{bad} pixels differ ({100.0 * bad / total:.2f}%), see {diff_path}")
+
+        render_us = timing["render_us"]
+        golden_us = golden_timings.get(scene, {}).get("render_us")
+        time_note = f"{render_us} us"
+        if golden_us and not args.no_timing:
+            time_note += f" (golden {golden_us} us)"
+            if render_us > golden_us * args.time_slack:
+                problems.append(f"render time {render_us} us > {args.time_slack}x golden {golden_us} us")
+
+        if problems:
+            failed += 1
+            print(f"FAIL {scene}: {'; '.join(problems)}")
+        else:
+            print(f"ok   {scene}: {time_note}")
+
+    if failed:
+        sys.exit(f"{failed} of {len(timings)} scenes failed")
+    print(f"All {len(timings)} scenes match")
+
+
+if __name__ == "__main__":
+    main()